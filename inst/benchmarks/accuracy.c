@@ -0,0 +1,498 @@
+/*  == expint: Exponential Integral and Incomplete Gamma Function ==
+ *
+ *  Accuracy driver for the routines of libexpint. Each routine is
+ *  evaluated on a dense regular grid of arguments in each of its
+ *  evaluation regions (interval of the Chebyshev expansions of E_1,
+ *  branch of gamma_inc, etc.), and the results are compared with
+ *  reference values computed in extended precision. The fast paths
+ *  (batch kernels, recurrences, interpolation tables and single
+ *  precision mode) are checked in the same regions as the scalar
+ *  routines.
+ *
+ *  The reference values are computed with MPFR when the driver is
+ *  compiled with HAVE_MPFR defined. Otherwise, they are computed in
+ *  long double precision from the representations
+ *
+ *    G(a,x) = e^(-x) x^(a-1) int_0^Inf (1 + v/x)^(a-1) e^(-v) dv,
+ *    E_n(x) = x^(n-1) G(1-n, x),
+ *    E_1(x) = -Ei(-x) = -gamma - log(-x) - sum_k (-x)^k/(k k!), x < 0,
+ *
+ *  the integral being evaluated with the trapezoidal rule in log v.
+ *  Both the integrand and the terms of the series are positive, hence
+ *  there is no cancellation and the reference values are accurate to
+ *  a small fraction of a unit in the last place (ULP) of a double.
+ *
+ *  The results are written on the standard output in CSV format, one
+ *  line per region and precision mode, with the number of points
+ *  compared, the number of points excluded because the reference
+ *  value overflows or underflows in double precision, the maximum
+ *  error in ULP and the arguments where it occurs, the median error
+ *  in ULP, the mean time per evaluation in nanoseconds and the number
+ *  of evaluations per second.
+ *
+ *  Usage: accuracy [points [seconds]]
+ *
+ *  where 'points' is the number of grid points per region (default
+ *  4096) and 'seconds' is the minimum time spent timing each region
+ *  (default 0.2). See the Makefile in this directory to build the
+ *  driver.
+ *
+ *  Copyright (C) 2026 Vincent Goulet
+ *
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU General Public License as
+ *  published by the Free Software Foundation; either version 3 of the
+ *  License, or (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ *  General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ *  02110-1301, USA.
+ *
+ *  AUTHOR: Vincent Goulet <vincent.goulet@act.ulaval.ca>
+ */
+
+#define _POSIX_C_SOURCE 199309L	/* for clock_gettime() */
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#ifdef HAVE_MPFR
+#include <mpfr.h>
+#endif
+#include "libexpint.h"
+
+enum {
+    E1, E1_BATCH, E1_TABLE, E2, E2_BATCH, EN, EN_SEQ,
+    GAMMA_INC, GAMMA_INC_LADDER, GAMMA_INC_TABLE
+};
+
+static const char *fun_names[] = {
+    "expint_E1", "expint_E1_batch", "expint_table_eval", "expint_E2",
+    "expint_E2_batch", "expint_En", "expint_En_seq", "gamma_inc",
+    "gamma_inc_ladder", "expint_table_eval"
+};
+
+/* Number of steps of the recurrences (orders amin, ..., amax for
+ * expint_En_seq) and tolerance of the interpolation tables */
+#define LADDER_K 8
+#define TABLE_TOL 1e-12
+
+/* Evaluation regions: routine, name, range of the first argument
+ * ('a' or the order 'n', unused for E_1 and E_2) and range of 'x' */
+static const struct region {
+    int fun;
+    const char *name;
+    double amin, amax, xmin, xmax;
+} regions[] = {
+    {E1, "(-Inf,-10]",            0, 0, -50.0, -10.0},
+    {E1, "(-10,-4]",              0, 0, -10.0, -4.0},
+    {E1, "(-4,-1]",               0, 0, -4.0, -1.0},
+    {E1, "(-1,1]",                0, 0, -1.0, 1.0},
+    {E1, "(1,4]",                 0, 0, 1.0, 4.0},
+    {E1, "(4,Inf)",               0, 0, 4.0, 50.0},
+    {E1_BATCH, "(-10,-1]",        0, 0, -10.0, -1.0},
+    {E1_BATCH, "(-1,1]",          0, 0, -1.0, 1.0},
+    {E1_BATCH, "(1,4]",           0, 0, 1.0, 4.0},
+    {E1_BATCH, "(4,Inf)",         0, 0, 4.0, 50.0},
+    {E1_TABLE, "E_1",             0, 0, 0.01, 50.0},
+    {E2, "x < 100",               0, 0, 0.01, 100.0},
+    {E2, "x >= 100",              0, 0, 100.0, 700.0},
+    {E2_BATCH, "x < 100",         0, 0, 0.01, 100.0},
+    {EN, "n = 3-10",              3, 10, 0.1, 10.0},
+    {EN, "n = 50-100",            50, 100, 0.1, 10.0},
+    {EN_SEQ, "n = 1-10",          1, 10, 0.1, 20.0},
+    {EN_SEQ, "n = 1-50",          1, 50, 0.1, 100.0},
+    {GAMMA_INC, "a = 0",          0, 0, 0.1, 10.0},
+    {GAMMA_INC, "a > 0",          0.5, 10.0, 0.1, 10.0},
+    {GAMMA_INC, "asymptotic",     -500.0, -100.0, 1.0, 50.0},
+    {GAMMA_INC, "continued fraction", -10.0, -0.5, 0.5, 20.0},
+    {GAMMA_INC, "-0.5 < a < 0",   -0.5, 0.0, 0.01, 0.25},
+    {GAMMA_INC, "series",         -50.0, -10.5, 0.01, 0.25},
+    {GAMMA_INC, "recursion",      -10.0, -0.5, 0.01, 0.25},
+    {GAMMA_INC_LADDER, "x <= 0.25", -5.0, 5.0, 0.01, 0.25},
+    {GAMMA_INC_LADDER, "x > 0.25", -5.0, 5.0, 0.25, 20.0},
+    {GAMMA_INC_TABLE, "a = -2.5", -2.5, -2.5, 0.1, 20.0},
+};
+
+#define NREGIONS (sizeof(regions) / sizeof(regions[0]))
+
+/* Number of values computed at each grid point */
+static int nvalues(const struct region *reg)
+{
+    switch (reg->fun)
+    {
+    case EN_SEQ:
+	return (int) (reg->amax - reg->amin) + 1;
+    case GAMMA_INC_LADDER:
+	return LADDER_K + 1;
+    default:
+	return 1;
+    }
+}
+
+/* Regular grid over the region for about 'n' values in all: 'na'
+ * values of the first argument (integers for E_n) times 'nx' values
+ * of 'x'. Returns the number of points. */
+static int grid(const struct region *reg, int n, double *a, double *x)
+{
+    int i, j, k = 0, na = 1, nx;
+
+    n /= nvalues(reg);
+    if (n < 2)
+	n = 2;
+    if (reg->amax > reg->amin && reg->fun != EN_SEQ)
+    {
+	na = (int) sqrt((double) n);
+	if (reg->fun == EN && na > reg->amax - reg->amin + 1)
+	    na = (int) (reg->amax - reg->amin) + 1;
+    }
+    nx = n / na;
+
+    for (i = 0; i < na; i++)
+    {
+	double ai = (na > 1) ?
+	    reg->amin + (reg->amax - reg->amin) * i / (na - 1) : reg->amin;
+	if (reg->fun == EN)
+	    ai = floor(ai + 0.5);
+	for (j = 0; j < nx; j++, k++)
+	{
+	    a[k] = ai;
+	    x[k] = (nx > 1) ?
+		reg->xmin + (reg->xmax - reg->xmin) * j / (nx - 1) : reg->xmin;
+	}
+    }
+    return k;
+}
+
+/* Values of the routine at the 'n' grid points, stored in 'y' with
+ * nvalues() consecutive values per point */
+static void evaluate(const struct region *reg, const expint_table *table,
+		     const double *a, const double *x, int n, double *y)
+{
+    int i, nmax = (int) reg->amax, m = nvalues(reg);
+
+    switch (reg->fun)
+    {
+    case E1:
+	for (i = 0; i < n; i++)
+	    y[i] = expint_E1(x[i], 0);
+	break;
+    case E1_BATCH:
+	expint_E1_batch(x, y, n, 0);
+	break;
+    case E2:
+	for (i = 0; i < n; i++)
+	    y[i] = expint_E2(x[i], 0);
+	break;
+    case E2_BATCH:
+	expint_E2_batch(x, y, n, 0);
+	break;
+    case EN:
+	for (i = 0; i < n; i++)
+	    y[i] = expint_En(x[i], (int) a[i], 0);
+	break;
+    case EN_SEQ:
+	/* orders 1, ..., nmax computed; orders amin, ..., nmax kept */
+	for (i = 0; i < n; i++)
+	{
+	    double tmp[128];
+	    expint_En_seq(x[i], nmax, 0, tmp, 1);
+	    for (int k = 0; k < m; k++)
+		y[i * m + k] = tmp[nmax - m + k];
+	}
+	break;
+    case GAMMA_INC:
+	for (i = 0; i < n; i++)
+	    y[i] = gamma_inc(a[i], x[i]);
+	break;
+    case GAMMA_INC_LADDER:
+	for (i = 0; i < n; i++)
+	    gamma_inc_ladder(a[i], x[i], LADDER_K, y + i * m, 1);
+	break;
+    case E1_TABLE:
+    case GAMMA_INC_TABLE:
+	expint_table_eval_vec(table, x, n, y);
+	break;
+    }
+}
+
+/*
+ * REFERENCE VALUES
+ */
+
+#ifdef HAVE_MPFR
+
+#define MPFR_BITS 256
+
+/* G(a,x) with MPFR, E_n(x) = x^(n-1) G(1-n, x) and E_1(x) = -Ei(-x) */
+static long double ref_gamma_inc(long double a, long double x)
+{
+    mpfr_t ma, mx, r;
+    long double res;
+
+    mpfr_inits2(MPFR_BITS, ma, mx, r, (mpfr_ptr) 0);
+    mpfr_set_ld(ma, a, MPFR_RNDN);
+    mpfr_set_ld(mx, x, MPFR_RNDN);
+    mpfr_gamma_inc(r, ma, mx, MPFR_RNDN);
+    res = mpfr_get_ld(r, MPFR_RNDN);
+    mpfr_clears(ma, mx, r, (mpfr_ptr) 0);
+    return res;
+}
+
+static long double ref_En(int n, long double x)
+{
+    mpfr_t ma, mx, r, p;
+    long double res;
+
+    mpfr_inits2(MPFR_BITS, ma, mx, r, p, (mpfr_ptr) 0);
+    mpfr_set_si(ma, 1 - n, MPFR_RNDN);
+    mpfr_set_ld(mx, x, MPFR_RNDN);
+    mpfr_gamma_inc(r, ma, mx, MPFR_RNDN);
+    mpfr_pow_si(p, mx, n - 1, MPFR_RNDN);
+    mpfr_mul(r, r, p, MPFR_RNDN);
+    res = mpfr_get_ld(r, MPFR_RNDN);
+    mpfr_clears(ma, mx, r, p, (mpfr_ptr) 0);
+    return res;
+}
+
+static long double ref_E1(long double x)
+{
+    mpfr_t mx, r;
+    long double res;
+
+    if (x > 0)
+	return ref_En(1, x);
+
+    mpfr_inits2(MPFR_BITS, mx, r, (mpfr_ptr) 0);
+    mpfr_set_ld(mx, -x, MPFR_RNDN);
+    mpfr_eint(r, mx, MPFR_RNDN);
+    res = -mpfr_get_ld(r, MPFR_RNDN);
+    mpfr_clears(mx, r, (mpfr_ptr) 0);
+    return res;
+}
+
+#else
+
+/* S(a,x) = int_0^Inf (1 + v/x)^(a-1) e^(-v) dv by the trapezoidal
+ * rule in t = log v. The integrand decays doubly exponentially as t
+ * -> Inf, from the upper limit on, and exponentially as t -> -Inf,
+ * where the sum stops once the tail is negligible. */
+static long double ref_S(long double a, long double x)
+{
+    const long double h = 1.0L/32;
+    long double t, v, f, sum = 0.0L;
+
+    for (t = logl(100.0L + 4.0L * fmaxl(a, 0.0L)); t > -200.0L; t -= h)
+    {
+	v = expl(t);
+	f = expl((a - 1.0L) * log1pl(v/x) - v) * v;
+	sum += f;
+	if (v < x && f < 1e-3L * LDBL_EPSILON * sum)
+	    break;
+    }
+    return h * sum;
+}
+
+static long double ref_gamma_inc(long double a, long double x)
+{
+    return expl(-x) * powl(x, a - 1.0L) * ref_S(a, x);
+}
+
+static long double ref_En(int n, long double x)
+{
+    return expl(-x) * ref_S(1.0L - n, x) / x;
+}
+
+static long double ref_E1(long double x)
+{
+    const long double euler = 0.577215664901532860606512090082402431L;
+    long double t = -x, term = 1.0L, sum = 0.0L;
+    int k;
+
+    if (x > 0)
+	return ref_En(1, x);
+
+    for (k = 1; k < 1000; k++)
+    {
+	term *= t / k;
+	sum += term / k;
+	if (term / k < LDBL_EPSILON * sum)
+	    break;
+    }
+    return -(euler + logl(t) + sum);
+}
+
+#endif
+
+/* Reference values at the grid points, in the layout of evaluate() */
+static void reference(const struct region *reg, const double *a,
+		      const double *x, int n, long double *ref)
+{
+    int i, k, m = nvalues(reg);
+
+    for (i = 0; i < n; i++)
+    {
+	switch (reg->fun)
+	{
+	case E1:
+	case E1_BATCH:
+	case E1_TABLE:
+	    ref[i] = ref_E1(x[i]);
+	    break;
+	case E2:
+	case E2_BATCH:
+	    ref[i] = ref_En(2, x[i]);
+	    break;
+	case EN:
+	    ref[i] = ref_En((int) a[i], x[i]);
+	    break;
+	case EN_SEQ:
+	    for (k = 0; k < m; k++)
+		ref[i * m + k] = ref_En((int) reg->amax - m + 1 + k, x[i]);
+	    break;
+	case GAMMA_INC:
+	case GAMMA_INC_TABLE:
+	    ref[i] = ref_gamma_inc(a[i], x[i]);
+	    break;
+	case GAMMA_INC_LADDER:
+	    for (k = 0; k < m; k++)
+		ref[i * m + k] = ref_gamma_inc((long double) a[i] - k, x[i]);
+	    break;
+	}
+    }
+}
+
+/* Error of 'y' in units in the last place of the reference value */
+static double ulp_error(double y, long double ref)
+{
+    int e;
+
+    if (isnan(y))
+	return INFINITY;
+    if (fabsl(ref) < DBL_MIN)
+	return fabsl(y - ref) / 0x1.0p-1074L;
+    frexpl(ref, &e);
+    return fabsl(y - ref) / ldexpl(1.0L, e - DBL_MANT_DIG);
+}
+
+static int compare(const void *p, const void *q)
+{
+    double u = *(const double *) p, v = *(const double *) q;
+    return (u > v) - (u < v);
+}
+
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+int main(int argc, char *argv[])
+{
+    int npoints = (argc > 1) ? atoi(argv[1]) : 4096;
+    double mintime = (argc > 2) ? atof(argv[2]) : 0.2;
+    double *a, *x, *y, *err;
+    long double *ref;
+    volatile double sink = 0.0;
+    size_t r;
+    int prec;
+
+    if (npoints < 2)
+	npoints = 2;
+    a = malloc(npoints * sizeof(double));
+    x = malloc(npoints * sizeof(double));
+    y = malloc(npoints * 64 * sizeof(double));
+    err = malloc(npoints * 64 * sizeof(double));
+    ref = malloc(npoints * 64 * sizeof(long double));
+    if (a == NULL || x == NULL || y == NULL || err == NULL || ref == NULL)
+    {
+	fprintf(stderr, "cannot allocate the grids\n");
+	return 1;
+    }
+
+    printf("function,region,precision,a_min,a_max,x_min,x_max,"
+	   "points,excluded,max_ulp,a_at_max,x_at_max,median_ulp,"
+	   "ns_per_eval,evals_per_sec\n");
+
+    for (r = 0; r < NREGIONS; r++)
+    {
+	const struct region *reg = &regions[r];
+	expint_table *table = NULL;
+	int i, n, m = nvalues(reg);
+
+	n = grid(reg, npoints, a, x);
+	reference(reg, a, x, n, ref);
+
+	if (reg->fun == E1_TABLE)
+	    table = expint_table_build(EXPINT_TABLE_E1, 0,
+				       reg->xmin, reg->xmax, TABLE_TOL);
+	else if (reg->fun == GAMMA_INC_TABLE)
+	    table = expint_table_build(EXPINT_TABLE_GAMMA_INC, reg->amin,
+				       reg->xmin, reg->xmax, TABLE_TOL);
+
+	for (prec = EXPINT_PREC_DOUBLE; prec <= EXPINT_PREC_SINGLE; prec++)
+	{
+	    double start, elapsed, maxerr = 0.0, aerr = NAN, xerr = NAN;
+	    long npass = 0;
+	    int ncomp = 0, nexcl = 0;
+
+	    expint_set_precision(prec);
+
+	    /* accuracy */
+	    evaluate(reg, table, a, x, n, y);
+	    for (i = 0; i < n * m; i++)
+	    {
+		if (isinf(ref[i]) || fabsl(ref[i]) > DBL_MAX ||
+		    fabsl(ref[i]) < DBL_MIN)
+		{
+		    nexcl++;
+		    continue;
+		}
+		err[ncomp] = ulp_error(y[i], ref[i]);
+		if (!(err[ncomp] <= maxerr))
+		{
+		    maxerr = err[ncomp];
+		    aerr = a[i / m] - ((reg->fun == GAMMA_INC_LADDER) ? i % m : 0);
+		    xerr = x[i / m];
+		}
+		ncomp++;
+	    }
+	    qsort(err, ncomp, sizeof(double), compare);
+
+	    /* throughput */
+	    evaluate(reg, table, a, x, n, y); /* warm up */
+	    start = now();
+	    do
+	    {
+		evaluate(reg, table, a, x, n, y);
+		sink += y[0];
+		npass++;
+		elapsed = now() - start;
+	    } while (elapsed < mintime);
+	    expint_take_status();
+
+	    printf("%s,\"%s\",%s,%g,%g,%g,%g,%d,%d,%.3g,%g,%g,%.3g,%.2f,%.0f\n",
+		   fun_names[reg->fun], reg->name,
+		   (prec == EXPINT_PREC_DOUBLE) ? "double" : "single",
+		   reg->amin, reg->amax, reg->xmin, reg->xmax,
+		   ncomp, nexcl, maxerr, aerr, xerr,
+		   (ncomp > 0) ? err[ncomp / 2] : NAN,
+		   1e9 * elapsed / (npass * n * m),
+		   npass * n * m / elapsed);
+	}
+	expint_set_precision(EXPINT_PREC_DOUBLE);
+	expint_table_free(table);
+    }
+
+    free(a); free(x); free(y); free(err); free(ref);
+    (void) sink;
+    return 0;
+}
@@ -0,0 +1,176 @@
+/*  == expint: Exponential Integral and Incomplete Gamma Function ==
+ *
+ *  Benchmark driver for the routines of libexpint. Each routine is
+ *  timed on a fixed set of pseudo-random arguments drawn in each of
+ *  its evaluation regions (interval of the Chebyshev expansions of
+ *  E_1, branch of gamma_inc, etc.). The results are written on the
+ *  standard output in CSV format, one line per region, with the mean
+ *  time per evaluation in nanoseconds and the number of evaluations
+ *  per second.
+ *
+ *  Usage: bench [seconds]
+ *
+ *  where 'seconds' is the minimum time spent in each region (default
+ *  0.2). See the Makefile in this directory to build the driver.
+ *
+ *  Copyright (C) 2026 Vincent Goulet
+ *
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU General Public License as
+ *  published by the Free Software Foundation; either version 3 of the
+ *  License, or (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ *  General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ *  02110-1301, USA.
+ *
+ *  AUTHOR: Vincent Goulet <vincent.goulet@act.ulaval.ca>
+ */
+
+#define _POSIX_C_SOURCE 199309L	/* for clock_gettime() */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "libexpint.h"
+
+#define NPOINTS 4096
+
+enum { E1, E2, EN, GAMMA_INC, GAMMA_INC_F_CF };
+
+static const char *fun_names[] = {
+    "expint_E1", "expint_E2", "expint_En", "gamma_inc", "gamma_inc_F_CF"
+};
+
+/* Evaluation regions: routine, name, range of the first argument
+ * ('a' or the order 'n', unused for E_1 and E_2) and range of 'x' */
+static const struct region {
+    int fun;
+    const char *name;
+    double amin, amax, xmin, xmax;
+} regions[] = {
+    {E1, "(-Inf,-10]",            0, 0, -50.0, -10.0},
+    {E1, "(-10,-4]",              0, 0, -10.0, -4.0},
+    {E1, "(-4,-1]",               0, 0, -4.0, -1.0},
+    {E1, "(-1,1]",                0, 0, -1.0, 1.0},
+    {E1, "(1,4]",                 0, 0, 1.0, 4.0},
+    {E1, "(4,Inf)",               0, 0, 4.0, 50.0},
+    {E2, "x < 100",               0, 0, 0.01, 100.0},
+    {E2, "x >= 100",              0, 0, 100.0, 700.0},
+    {EN, "n = 3-10",              3, 10, 0.1, 10.0},
+    {EN, "n = 50-100",            50, 100, 0.1, 10.0},
+    {GAMMA_INC, "a = 0",          0, 0, 0.1, 10.0},
+    {GAMMA_INC, "a > 0",          0.5, 10.0, 0.1, 10.0},
+    {GAMMA_INC, "asymptotic",     -500.0, -100.0, 1.0, 50.0},
+    {GAMMA_INC, "continued fraction", -10.0, -0.5, 0.5, 20.0},
+    {GAMMA_INC, "-0.5 < a < 0",   -0.5, 0.0, 0.01, 0.25},
+    {GAMMA_INC, "series",         -50.0, -10.5, 0.01, 0.25},
+    {GAMMA_INC, "recursion",      -10.0, -0.5, 0.01, 0.25},
+    {GAMMA_INC_F_CF, "0.25 < x <= 20", -10.0, -0.5, 0.25, 20.0},
+    {GAMMA_INC_F_CF, "x > 20",    -10.0, -0.5, 20.0, 200.0},
+};
+
+#define NREGIONS (sizeof(regions) / sizeof(regions[0]))
+
+/* Uniform pseudo-random numbers in [0, 1) with a fixed seed so that
+ * the arguments are the same from one run to the next */
+static unsigned long long seed = 88172645463325252ULL;
+
+static double unif(void)
+{
+    seed ^= seed << 13;
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+    return (seed >> 11) * 0x1.0p-53;
+}
+
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+/* One pass over the arguments of a region; the sum of the results
+ * is returned so that the calls are not optimized away */
+static double pass(int fun, const double *a, const double *x)
+{
+    double sum = 0.0;
+    int i;
+
+    switch (fun)
+    {
+    case E1:
+	for (i = 0; i < NPOINTS; i++)
+	    sum += expint_E1(x[i], 0);
+	break;
+    case E2:
+	for (i = 0; i < NPOINTS; i++)
+	    sum += expint_E2(x[i], 0);
+	break;
+    case EN:
+	for (i = 0; i < NPOINTS; i++)
+	    sum += expint_En(x[i], (int) a[i], 0);
+	break;
+    case GAMMA_INC:
+	for (i = 0; i < NPOINTS; i++)
+	    sum += gamma_inc(a[i], x[i]);
+	break;
+    case GAMMA_INC_F_CF:
+	for (i = 0; i < NPOINTS; i++)
+	    sum += gamma_inc_F_CF(a[i], x[i]);
+	break;
+    }
+    return sum;
+}
+
+int main(int argc, char *argv[])
+{
+    static double a[NPOINTS], x[NPOINTS];
+    double mintime = (argc > 1) ? atof(argv[1]) : 0.2;
+    volatile double sink = 0.0;
+    size_t r;
+    int i;
+
+    printf("function,region,a_min,a_max,x_min,x_max,evals,ns_per_eval,evals_per_sec\n");
+
+    for (r = 0; r < NREGIONS; r++)
+    {
+	const struct region *reg = &regions[r];
+	double start, elapsed;
+	long npass = 0;
+
+	for (i = 0; i < NPOINTS; i++)
+	{
+	    a[i] = reg->amin + (reg->amax - reg->amin) * unif();
+	    x[i] = reg->xmin + (reg->xmax - reg->xmin) * unif();
+	    if (reg->fun == EN)
+		a[i] = (double) (long) (a[i] + 0.5);
+	}
+
+	sink += pass(reg->fun, a, x); /* warm up */
+	start = now();
+	do
+	{
+	    sink += pass(reg->fun, a, x);
+	    npass++;
+	    elapsed = now() - start;
+	} while (elapsed < mintime);
+	expint_take_status();
+
+	printf("%s,\"%s\",%g,%g,%g,%g,%ld,%.2f,%.0f\n",
+	       fun_names[reg->fun], reg->name,
+	       reg->amin, reg->amax, reg->xmin, reg->xmax,
+	       npass * NPOINTS,
+	       1e9 * elapsed / (npass * NPOINTS),
+	       npass * NPOINTS / elapsed);
+    }
+
+    (void) sink;
+    return 0;
+}
@@ -37,7 +37,7 @@ SEXP pkg_do_foo(SEXP args)
 {
     SEXP sx, sy;
     int i, nx;
-    double xi, *x, *y;
+    double *x, *y;
     Rboolean naflag = FALSE;
 
     if (!isNumeric(CADR(args)))
@@ -52,19 +52,17 @@ SEXP pkg_do_foo(SEXP args)
     x = REAL(sx);
     y = REAL(sy);
 
+    /* this is where the expint batch routine is used; NA and NaN
+     * values are passed through */
+    pkg_expint_E1_vec(x, nx, 1, 0, y);
+
     for (i = 0; i < nx; i++)
     {
-        xi = x[i];
-	if (ISNA(xi))
-	    y[i] = NA_REAL;			\
-        else if (ISNAN(xi))
-	    y[i] = R_NaN;
-        else
-        {
-	    /* this is where the expint routine is used */
-            y[i] = pkg_expint_E1(xi, 0);
-            if (ISNAN(y[i])) naflag = TRUE;
-        }
+	if (ISNAN(y[i]) && !ISNAN(x[i]))
+	{
+	    naflag = TRUE;
+	    break;
+	}
     }
 
     if (naflag)
@@ -47,8 +47,11 @@ void R_init_pkg(DllInfo *dll)
     /* native interfaces to routines from package expint */
     pkg_expint_E1 = (double(*)(double,int))    R_GetCCallable("expint", "expint_E1");
     pkg_gamma_inc = (double(*)(double,double)) R_GetCCallable("expint", "gamma_inc");
+    pkg_expint_E1_vec = (void(*)(const double*,R_xlen_t,R_xlen_t,int,double*))
+	R_GetCCallable("expint", "expint_E1_vec");
 }
 
 /* Declaration of interfaces to routines from package expint */
 double(*pkg_expint_E1)(double,int);
 double(*pkg_gamma_inc)(double,double);
+void(*pkg_expint_E1_vec)(const double*,R_xlen_t,R_xlen_t,int,double*);
@@ -10,3 +10,4 @@ SEXP pkg_do_bar(SEXP args);
 /* Interfaces to routines from package expint */
 extern double(*pkg_expint_E1)(double,int);
 extern double(*pkg_gamma_inc)(double,double);
+extern void(*pkg_expint_E1_vec)(const double*,R_xlen_t,R_xlen_t,int,double*);
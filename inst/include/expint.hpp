@@ -0,0 +1,852 @@
+/*  == expint: Exponential Integral and Incomplete Gamma Function ==
+ *
+ *  Header-only C++ interface to the computational kernels of the
+ *  package, for code (Rcpp packages, for instance) that wants to
+ *  inline the functions in its own loops rather than call them
+ *  through the function pointers of expintAPI.h.
+ *
+ *  The functions are templates on the floating point type of the
+ *  arguments and, at compile time, on the scaling and the order of
+ *  the exponential integral:
+ *
+ *    E1<Scale>(x), E2<Scale>(x), En<N, Scale>(x), gamma_inc<Scale>(a, x)
+ *
+ *  with 'Scale' false by default; the scaled functions are e^x E_n(x)
+ *  and e^x x^(1-a) G(a,x). Each one also has a batch version taking
+ *  either a pair of iterators and an output iterator, as the
+ *  algorithms of the standard library, or an input and an output
+ *  contiguous range (std::span, std::vector, std::array, ...).
+ *
+ *  The kernels are those of libexpint (see src/libexpint in the
+ *  package sources), with the coefficients of the Chebyshev
+ *  expansions in constexpr tables. With float arguments, the
+ *  expansions are truncated at their single precision order and the
+ *  iterations stop at relative tolerance FLT_EPSILON, as after
+ *  expint_set_precision(EXPINT_PREC_SINGLE); wider types are computed
+ *  to double precision. Unlike the routines of expintAPI.h, these
+ *  functions never issue warnings, do not record statistics and do
+ *  not use the cache: results that overflow are infinite and results
+ *  that underflow are 0. Only gamma_inc() for a > 0, or for
+ *  non-integer a, calls the R math library (functions 'gammafn',
+ *  'pgamma', etc.), in double precision.
+ *
+ *  Requires C++17.
+ *
+ *  Copyright (C) 2026 Vincent Goulet
+ *
+ *  The code is derived from the GNU Scientific Library (GSL) v2.2.1
+ *  <https://www.gnu.org/software/gsl/>
+ *
+ *  Copyright (C) 2007 Brian Gough
+ *  Copyright (C) 1996, 1997, 1998, 1999, 2000, 2001, 2002 Gerard Jungman
+ *
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU General Public License as
+ *  published by the Free Software Foundation; either version 3 of the
+ *  License, or (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ *  General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ *  02110-1301, USA.
+ *
+ *  AUTHOR for the GSL: G. Jungman
+ *  AUTHOR for expint: Vincent Goulet <vincent.goulet@act.ulaval.ca>
+ */
+
+#ifndef EXPINT_HPP
+#define EXPINT_HPP
+
+#if __cplusplus < 201703L
+#error "expint.hpp requires C++17"
+#endif
+
+#include <cfloat>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <Rmath.h>
+
+namespace expint {
+
+namespace detail {
+
+/*
+ *  CHEBYSHEV EXPANSIONS
+ *
+ *  Coefficients of the expansions of expint_E1() over [-1, 1], with
+ *  their double and single precision orders; see libexpint/expint.c
+ *  for the sources.
+ */
+struct AE11_cs {
+    static constexpr int order = 38, order_sp = 20;
+    static constexpr double c[39] = {
+       0.121503239716065790,
+      -0.065088778513550150,
+       0.004897651357459670,
+      -0.000649237843027216,
+       0.000093840434587471,
+       0.000000420236380882,
+      -0.000008113374735904,
+       0.000002804247688663,
+       0.000000056487164441,
+      -0.000000344809174450,
+       0.000000058209273578,
+       0.000000038711426349,
+      -0.000000012453235014,
+      -0.000000005118504888,
+       0.000000002148771527,
+       0.000000000868459898,
+      -0.000000000343650105,
+      -0.000000000179796603,
+       0.000000000047442060,
+       0.000000000040423282,
+      -0.000000000003543928,
+      -0.000000000008853444,
+      -0.000000000000960151,
+       0.000000000001692921,
+       0.000000000000607990,
+      -0.000000000000224338,
+      -0.000000000000200327,
+      -0.000000000000006246,
+       0.000000000000045571,
+       0.000000000000016383,
+      -0.000000000000005561,
+      -0.000000000000006074,
+      -0.000000000000000862,
+       0.000000000000001223,
+       0.000000000000000716,
+      -0.000000000000000024,
+      -0.000000000000000201,
+      -0.000000000000000082,
+       0.000000000000000017
+    };
+};
+
+struct AE12_cs {
+    static constexpr int order = 24, order_sp = 15;
+    static constexpr double c[25] = {
+       0.582417495134726740,
+      -0.158348850905782750,
+      -0.006764275590323141,
+       0.005125843950185725,
+       0.000435232492169391,
+      -0.000143613366305483,
+      -0.000041801320556301,
+      -0.000002713395758640,
+       0.000001151381913647,
+       0.000000420650022012,
+       0.000000066581901391,
+       0.000000000662143777,
+      -0.000000002844104870,
+      -0.000000000940724197,
+      -0.000000000177476602,
+      -0.000000000015830222,
+       0.000000000002905732,
+       0.000000000001769356,
+       0.000000000000492735,
+       0.000000000000093709,
+       0.000000000000010707,
+      -0.000000000000000537,
+      -0.000000000000000716,
+      -0.000000000000000244,
+      -0.000000000000000058
+    };
+};
+
+struct E11_cs {
+    static constexpr int order = 18, order_sp = 13;
+    static constexpr double c[19] = {
+      -16.11346165557149402600,
+        7.79407277874268027690,
+       -1.95540581886314195070,
+        0.37337293866277945612,
+       -0.05692503191092901938,
+        0.00721107776966009185,
+       -0.00078104901449841593,
+        0.00007388093356262168,
+       -0.00000620286187580820,
+        0.00000046816002303176,
+       -0.00000003209288853329,
+        0.00000000201519974874,
+       -0.00000000011673686816,
+        0.00000000000627627066,
+       -0.00000000000031481541,
+        0.00000000000001479904,
+       -0.00000000000000065457,
+        0.00000000000000002733,
+       -0.00000000000000000108
+    };
+};
+
+struct E12_cs {
+    static constexpr int order = 15, order_sp = 10;
+    static constexpr double c[16] = {
+      -0.03739021479220279500,
+       0.04272398606220957700,
+      -0.13031820798497005440,
+       0.01441912402469889073,
+      -0.00134617078051068022,
+       0.00010731029253063780,
+      -0.00000742999951611943,
+       0.00000045377325690753,
+      -0.00000002476417211390,
+       0.00000000122076581374,
+      -0.00000000005485141480,
+       0.00000000000226362142,
+      -0.00000000000008635897,
+       0.00000000000000306291,
+      -0.00000000000000010148,
+       0.00000000000000000315
+    };
+};
+
+struct AE13_cs {
+    static constexpr int order = 24, order_sp = 15;
+    static constexpr double c[25] = {
+      -0.605773246640603460,
+      -0.112535243483660900,
+       0.013432266247902779,
+      -0.001926845187381145,
+       0.000309118337720603,
+      -0.000053564132129618,
+       0.000009827812880247,
+      -0.000001885368984916,
+       0.000000374943193568,
+      -0.000000076823455870,
+       0.000000016143270567,
+      -0.000000003466802211,
+       0.000000000758754209,
+      -0.000000000168864333,
+       0.000000000038145706,
+      -0.000000000008733026,
+       0.000000000002023672,
+      -0.000000000000474132,
+       0.000000000000112211,
+      -0.000000000000026804,
+       0.000000000000006457,
+      -0.000000000000001568,
+       0.000000000000000383,
+      -0.000000000000000094,
+       0.000000000000000023
+    };
+};
+
+struct AE14_cs {
+    static constexpr int order = 25, order_sp = 13;
+    static constexpr double c[26] = {
+      -0.18929180007530170,
+      -0.08648117855259871,
+       0.00722410154374659,
+      -0.00080975594575573,
+       0.00010999134432661,
+      -0.00001717332998937,
+       0.00000298562751447,
+      -0.00000056596491457,
+       0.00000011526808397,
+      -0.00000002495030440,
+       0.00000000569232420,
+      -0.00000000135995766,
+       0.00000000033846628,
+      -0.00000000008737853,
+       0.00000000002331588,
+      -0.00000000000641148,
+       0.00000000000181224,
+      -0.00000000000052538,
+       0.00000000000015592,
+      -0.00000000000004729,
+       0.00000000000001463,
+      -0.00000000000000461,
+       0.00000000000000148,
+      -0.00000000000000048,
+       0.00000000000000016,
+      -0.00000000000000005
+    };
+};
+
+/* Precision of the computations for type T: single for types not
+ * wider than float */
+template <typename T>
+struct prec {
+    static_assert(std::is_floating_point<T>::value,
+		  "expint: arguments must be of a floating point type");
+    static constexpr bool single = std::numeric_limits<T>::digits <= FLT_MANT_DIG;
+    static constexpr T eps = single ? T(FLT_EPSILON) : T(DBL_EPSILON);
+};
+
+/* Clenshaw recurrence of cheb_eval() up to the order of the
+ * expansion for type T, known at compile time */
+template <typename CS, typename T>
+inline T cheb_eval(T y)
+{
+    constexpr int order = prec<T>::single ? CS::order_sp : CS::order;
+    const T y2 = 2 * y;
+    T d = 0, dd = 0;
+
+    for (int j = order; j >= 1; j--)
+    {
+	const T temp = d;
+	d = y2 * d - dd + T(CS::c[j]);
+	dd = temp;
+    }
+
+    return y * d - dd + T(0.5) * T(CS::c[0]);
+}
+
+/* Limit -log(min) - log(-log(min)) of the argument beyond which
+ * e^{-x}/x underflows in type T */
+template <typename T>
+inline T E1_xmax()
+{
+    const T xmaxt = -std::log(std::numeric_limits<T>::min());
+    return xmaxt - std::log(xmaxt);
+}
+
+/* Exponential integral E_1(x), scaled by e^x when 'Scale' is true;
+ * expint_E1_impl() without the signals */
+template <bool Scale, typename T>
+inline T E1_impl(T x)
+{
+    if (std::isnan(x))
+	return x;
+
+    const T xmax = detail::E1_xmax<T>();
+
+    if (x < -xmax && !Scale)
+	return std::numeric_limits<T>::infinity();
+    else if (x <= -10)
+    {
+	const T s = 1 / x * (Scale ? T(1) : std::exp(-x));
+	return s * (1 + cheb_eval<AE11_cs>(20 / x + 1));
+    }
+    else if (x <= -4)
+    {
+	const T s = 1 / x * (Scale ? T(1) : std::exp(-x));
+	return s * (1 + cheb_eval<AE12_cs>((40 / x + 7) / 3));
+    }
+    else if (x <= -1)
+    {
+	const T s = Scale ? std::exp(x) : T(1);
+	return s * (-std::log(std::fabs(x)) + cheb_eval<E11_cs>((2 * x + 5) / 3));
+    }
+    else if (x == 0)
+	return std::numeric_limits<T>::quiet_NaN();
+    else if (x <= 1)
+    {
+	const T s = Scale ? std::exp(x) : T(1);
+	return s * (-std::log(std::fabs(x)) - T(0.6875) + x + cheb_eval<E12_cs>(x));
+    }
+    else if (x <= 4)
+    {
+	const T s = 1 / x * (Scale ? T(1) : std::exp(-x));
+	return s * (1 + cheb_eval<AE13_cs>((8 / x - 5) / 3));
+    }
+    else if (x <= xmax || Scale)
+    {
+	const T s = 1 / x * (Scale ? T(1) : std::exp(-x));
+	return s * (1 + cheb_eval<AE14_cs>(8 / x - 1));
+    }
+    else
+	return 0;
+}
+
+/*
+ *  INCOMPLETE GAMMA FUNCTION
+ *
+ *  Continued fraction, uniform asymptotic expansion and series of
+ *  libexpint/gamma_inc.c.
+ */
+template <typename T>
+inline T gamma_inc_F_CF(T a, T x)
+{
+    const int nmax = 5000;
+    const T eps = prec<T>::eps;
+    const T small = eps * eps * eps;
+
+    T hn = 1, Cn = 1 / small, Dn = 1;
+
+    /* n == 1 has a_1, b_1, b_0 independent of a,x,
+       so that has been done by hand                */
+    for (int n = 2; n < nmax; n++)
+    {
+	const T an = (n & 1) ? T(0.5) * (n - 1) / x : (T(0.5) * n - a) / x;
+
+	Dn = 1 + an * Dn;
+	if (std::fabs(Dn) < small)
+	    Dn = small;
+	Cn = 1 + an / Cn;
+	if (std::fabs(Cn) < small)
+	    Cn = small;
+	Dn = 1 / Dn;
+	const T delta = Cn * Dn;
+	hn *= delta;
+	if (std::fabs(delta - 1) < eps)
+	    break;
+    }
+
+    return hn;
+}
+
+/* Coefficients of the polynomials b_k(t) of the uniform asymptotic
+ * expansion for large negative 'a' [DLMF 8.11.6] */
+constexpr int gamma_inc_ua_nterms = 20;
+inline constexpr double gamma_inc_ua_b[] = {
+    /* b_1 */ 1.0,
+    /* b_2 */ 1.0, 2.0,
+    /* b_3 */ 1.0, 8.0, 6.0,
+    /* b_4 */ 1.0, 22.0, 58.0, 24.0,
+    /* b_5 */ 1.0, 52.0, 328.0, 444.0, 120.0,
+    /* b_6 */ 1.0, 114.0, 1452.0, 4400.0, 3708.0, 720.0,
+    /* b_7 */ 1.0, 240.0, 5610.0, 32120.0, 58140.0, 33984.0, 5040.0,
+    /* b_8 */ 1.0, 494.0, 19950.0, 195800.0, 644020.0, 785304.0, 341136.0,
+	40320.0,
+    /* b_9 */ 1.0, 1004.0, 67260.0, 1062500.0, 5765500.0, 12440064.0,
+	11026296.0, 3733920.0, 362880.0,
+    /* b_10 */ 1.0, 2026.0, 218848.0, 5326160.0, 44765000.0, 155357384.0,
+	238904904.0, 162186912.0, 44339040.0, 3628800.0,
+    /* b_11 */ 1.0, 4072.0, 695038.0, 25243904.0, 314369720.0,
+	1648384304.0, 4002695088.0, 4642163952.0, 2507481216.0, 568356480.0,
+	39916800.0,
+    /* b_12 */ 1.0, 8166.0, 2170626.0, 114876376.0, 2051482776.0,
+	15548960784.0, 56041398784.0, 101180433024.0, 92199790224.0,
+	40788301824.0, 7827719040.0, 479001600.0,
+    /* b_13 */ 1.0, 16356.0, 6699696.0, 507259276.0, 12669817776.0,
+	134323420224.0, 687720046384.0, 1818188642304.0, 2549865473424.0,
+	1883079661824.0, 697929436800.0, 115336085760.0, 6227020800.0,
+    /* b_14 */ 1.0, 32738.0, 20507988.0, 2189829808.0, 75016052228.0,
+	1084676512416.0, 7634832149392.0, 28299910066112.0, 57494373464592.0,
+	64728375139872.0, 39689578055808.0, 12550904017920.0, 1810992556800.0,
+	87178291200.0,
+    /* b_15 */ 1.0, 65504.0, 62407890.0, 9292526920.0, 429826006340.0,
+	8308444327968.0, 78391384831312.0, 394365587815520.0, 1111747472569680.0,
+	1797171220690560.0, 1666424486271456.0, 865023253219584.0,
+	236908271543040.0, 30196376985600.0, 1307674368000.0,
+    /* b_16 */ 1.0, 131038.0, 189123286.0, 38917528600.0, 2400028258540.0,
+	61026142132648.0, 756450802018384.0, 5036317938475648.0,
+	19076135772884080, 42430156603438560, 56071264983487776,
+	43708768764064128, 19515249341231616, 4687098165573120.0,
+	532953524275200.0, 20922789888000.0,
+    /* b_17 */ 1.0, 262108.0, 571432036.0, 161343812980.0,
+	13128749622100.0, 433357644035008.0, 6942861451710184.0,
+	59958264360283168, 2.9759317041784794e+17, 8.8212882458360346e+17,
+	1.5926775166974525e+18, 1.7580730548055007e+18, 1.1715823854813578e+18,
+	4.55924361142656e+17, 97049168010017280, 9927928075161600,
+	355687428096000.0,
+    /* b_18 */ 1.0, 524250.0, 1722945672.0, 663661077072.0,
+	70645406312880.0, 2994008352873048.0, 61167401838986520,
+	6.7406623553015053e+17, 4.297211671488277e+18, 1.655871067670008e+19,
+	3.9572673298262065e+19, 5.9321137058404868e+19, 5.5666251271784161e+19,
+	3.2157753536587055e+19, 1.1030149104146035e+19, 2.0998302094029312e+18,
+	1.946773197057024e+17, 6402373705728000.0,
+    /* b_19 */ 1.0, 1048536.0, 5187185766.0, 2713224461136.0,
+	375127847107776.0, 20224703119250448, 5.2098607181197011e+17,
+	7.2275519394107996e+18, 5.8222825873768858e+19, 2.8590903356867255e+20,
+	8.8238459455178487e+20, 1.740743150455672e+21, 2.2066896929933157e+21,
+	1.7861985800350387e+21, 9.0508056790369278e+20, 2.7626056364165969e+20,
+	4.7405948832458498e+19, 4.008789120817152e+18, 1.21645100408832e+17,
+    /* b_20 */ 1.0, 2097110.0, 15600353130.0, 11039636532120.0,
+	1970602091678640.0, 1.3410256551716707e+17, 4.3143177056190556e+18,
+	7.4491969813269447e+19, 7.4805954298565453e+20, 4.6057751118997912e+21,
+	1.7997592513561139e+22, 4.5595686452918042e+22, 7.5687031071216257e+22,
+	8.2380712138316758e+22, 5.8231173019431361e+22, 2.6142102647955182e+22,
+	7.1598940939099665e+21, 1.1150890784887957e+21, 8.6495828444928e+19,
+	2.43290200817664e+18
+};
+
+/* Sum of the expansion divided by x - a */
+template <typename T>
+inline T gamma_inc_ua_sum(T a, T x)
+{
+    const T lambda = x / a;
+    const T r = -a / ((x - a) * (x - a));
+    const double *c = gamma_inc_ua_b;
+    T sum = 1, rk = 1;
+
+    for (int k = 1; k <= gamma_inc_ua_nterms; k++)
+    {
+	/* b_k(lambda) and b_k(|lambda|) by Horner's scheme */
+	T p = T(c[k - 1]), q = p;
+	for (int j = k - 2; j >= 0; j--)
+	{
+	    p = p * lambda + T(c[j]);
+	    q = q * (-lambda) + T(c[j]);
+	}
+	c += k;
+	rk *= r;
+	sum += rk * lambda * p;
+	if (-rk * lambda * q < prec<T>::eps * std::fabs(sum))
+	    break;
+    }
+
+    return sum / (x - a);
+}
+
+/* Sum of the series of the lower incomplete gamma function for large
+ * negative non-integer 'a' and small 'x', with the term of order
+ * k = -a added when the loop stopped before it */
+template <typename T>
+inline T gamma_inc_series_sum(T a, T x)
+{
+    const T m = -std::nearbyint(a);
+    T sum = 1 / a, term = 1;
+    int k;
+
+    for (k = 1; k < 200; k++)
+    {
+	term *= -x / k;
+	const T t = term / (a + k);
+	sum += t;
+	if (std::fabs(t) < prec<T>::eps * std::fabs(sum))
+	    break;
+    }
+    if (k < m &&
+	std::fabs(term) > prec<T>::eps * std::fabs(sum) * std::fabs(a + m))
+    {
+	const T t = T(std::exp(double(m) * std::log(double(x)) -
+			       lgammafn(double(m) + 1.0))) / (a + m);
+	sum += (std::fmod(m, T(2)) == 0 ? t : -t);
+    }
+    return sum;
+}
+
+/* Gamma function for -170 < a < -10, 'a' not an integer, by the
+ * reflection formula, so that 'gammafn' is only called for positive
+ * arguments, where it does not warn */
+inline double gamma_neg(double a)
+{
+    const double n = std::nearbyint(a);
+    const double s = std::sin(M_PI * (a - n));
+
+    return M_PI / ((std::fmod(n, 2.0) == 0 ? s : -s) * gammafn(1.0 - a));
+}
+
+/* Upper incomplete gamma function of the R math library for a > 0 */
+inline double gamma_inc_rmath(double a, double x)
+{
+    return gammafn(a) * pgamma(x, a, 1, 0, 0);
+}
+
+/* Unscaled function for x > 0 and a < 0; branches of
+ * gamma_inc_impl() */
+template <typename T>
+inline T gamma_inc_neg(T a, T x)
+{
+    const T lx = std::log(x);
+
+    if (x > T(0.25) && a <= -100 && x < -100 * a)
+	return std::exp(a * lx - x) * gamma_inc_ua_sum(a, x);
+    else if (x > T(0.25))
+	return std::exp((a - 1) * lx - x) * gamma_inc_F_CF(a, x);
+    else if (std::fabs(a) < T(0.5))
+    {
+	const T gax = T(gamma_inc_rmath(double(a) + 1.0, double(x)));
+	return (gax - std::exp(-x + a * lx)) / a;
+    }
+    else if (a < -10 &&
+	     std::fabs(a - std::nearbyint(a)) > T(1e-7) * std::fabs(a))
+    {
+	const T sum = gamma_inc_series_sum(a, x);
+	const T t = std::exp(a * lx + std::log(std::fabs(sum)));
+	return (a > -170 ? T(gamma_neg(double(a))) : T(0)) - (sum < 0 ? -t : t);
+    }
+    else
+    {
+	/* a = fa + da; da >= 0 */
+	const T fa = std::floor(a);
+	const T da = a - fa;
+
+	T gax = (da > 0 ? T(gamma_inc_rmath(double(da), double(x)))
+		 : E1_impl<false>(x));
+	T alpha = da;
+
+	/* Gamma(alpha-1,x) = 1/(alpha-1) (Gamma(a,x) - x^(alpha-1) e^-x),
+	 * dividing on the log scale when the shift alone overflows */
+	do
+	{
+	    const T lshift = -x + (alpha - 1) * lx;
+	    if (lshift < std::log(std::numeric_limits<T>::max()))
+		gax = (gax - std::exp(lshift)) / (alpha - 1);
+	    else
+		gax = gax / (alpha - 1) + std::exp(lshift - std::log(1 - alpha));
+	    alpha -= 1;
+	} while (alpha > a);
+
+	return gax;
+    }
+}
+
+/* Scaled function e^x x^(1-a) G(a,x) for x > 0 and a != 0, as m e^es
+ * with the factor 'm' and exponent 'es' of gamma_inc_split() */
+template <typename T>
+inline T gamma_inc_scaled(T a, T x)
+{
+    const T lx = std::log(x);
+
+    if (a > 0 && (x <= T(0.25) || x <= a + 1))
+    {
+	/* Q(a,x) over the density of the gamma distribution */
+	return T(std::exp(pgamma(double(x), double(a), 1, 0, 1) -
+			  dgamma(double(x), double(a), 1, 1)));
+    }
+    else if (x > T(0.25) && a <= -100 && x < -100 * a)
+	return x * gamma_inc_ua_sum(a, x);
+    else if (x > T(0.25))
+	return gamma_inc_F_CF(a, x);
+    else if (std::fabs(a) < T(0.5))
+	return gamma_inc_neg(a, x) * std::exp(x + (1 - a) * lx);
+    else if (a < -10 &&
+	     std::fabs(a - std::nearbyint(a)) > T(1e-7) * std::fabs(a))
+	return ((a > -170 ? T(gamma_neg(double(a))) * std::exp(-a * lx) : T(0))
+		- gamma_inc_series_sum(a, x)) * std::exp(x + lx);
+    else
+    {
+	/* recursion on the scaled function S(alpha,x):
+	 *
+	 *   S(alpha-1,x) = x (S(alpha,x) - 1)/(alpha-1) */
+	const T fa = std::floor(a);
+	const T da = a - fa;
+
+	T s = (da > 0 ?
+	       T(gamma_inc_rmath(double(da), double(x))) *
+	       std::exp(x + (1 - da) * lx) :
+	       x * E1_impl<true>(x));
+	T alpha = da;
+
+	do
+	{
+	    s = x * (s - 1) / (alpha - 1);
+	    alpha -= 1;
+	} while (alpha > a);
+
+	return s;
+    }
+}
+
+/* Scaled function e^x x^(1-a) G(a,x) for a = 1 - n, n >= 3, and
+ * x > 0: the branches of gamma_inc_split() that do not depend on the
+ * R math library */
+template <typename T>
+inline T En_scaled(int n, T x)
+{
+    const T a = T(1 - n);
+
+    if (x > T(0.25) && a <= -100 && x < -100 * a)
+	return x * gamma_inc_ua_sum(a, x);
+    else if (x > T(0.25))
+	return gamma_inc_F_CF(a, x);
+    else
+    {
+	T s = x * E1_impl<true>(x);
+
+	for (T alpha = 0; alpha > a; alpha -= 1)
+	    s = x * (s - 1) / (alpha - 1);
+	return s;
+    }
+}
+
+} /* namespace detail */
+
+/*
+ *  SCALAR FUNCTIONS
+ */
+
+/* Exponential integral E_1(x), or e^x E_1(x) when 'Scale' is true */
+template <bool Scale = false, typename T>
+inline T E1(T x)
+{
+    return detail::E1_impl<Scale>(x);
+}
+
+/* Exponential integral E_2(x), or e^x E_2(x) when 'Scale' is true */
+template <bool Scale = false, typename T>
+inline T E2(T x)
+{
+    if (std::isnan(x))
+	return x;
+
+    const T xmax = detail::E1_xmax<T>();
+
+    if (x < -xmax && !Scale)
+	return std::numeric_limits<T>::infinity();
+    else if (x == 0)
+	return 1;
+    else if (x < 100)
+    {
+	const T ex = Scale ? T(1) : std::exp(-x);
+	return ex - x * detail::E1_impl<Scale>(x);
+    }
+    else if (x < xmax || Scale)
+    {
+	/* asymptotic series with coefficients (-1)^k (k+1)! */
+	const T s = Scale ? T(1) : std::exp(-x);
+	const T y = 1 / x;
+	const T sum6 = T(5040.0) + y * (T(-40320.0) + y * (T(362880.0) +
+		       y * (T(-3628800.0) + y * (T(39916800.0) +
+		       y * (T(-479001600.0) + y * (T(6227020800.0) +
+		       y * T(-87178291200.0)))))));
+	const T sum = y * (T(-2.0) + y * (T(6.0) + y * (T(-24.0) +
+		      y * (T(120.0) + y * (T(-720.0) + y * sum6)))));
+	return s * (1 + sum) / x;
+    }
+    else
+	return 0;
+}
+
+/* Exponential integral E_N(x) of order N >= 0, or e^x E_N(x) when
+ * 'Scale' is true */
+template <int N, bool Scale = false, typename T>
+inline T En(T x)
+{
+    static_assert(N >= 0, "expint: the order must be non negative");
+
+    if constexpr (N == 1)
+	return E1<Scale>(x);
+    else if constexpr (N == 2)
+	return E2<Scale>(x);
+    else
+    {
+	if (std::isnan(x))
+	    return x;
+
+	T res;
+	if constexpr (N == 0)
+	{
+	    if (x == 0)
+		return std::numeric_limits<T>::quiet_NaN();
+	    res = (Scale ? T(1) : std::exp(-x)) / x;
+	}
+	else
+	{
+	    if (x < 0)
+		return std::numeric_limits<T>::quiet_NaN();
+	    if (x == 0)
+		return T(1) / (N - 1);
+	    /* E_n(x) = e^{-x} S(1-n,x)/x */
+	    res = detail::En_scaled(N, x) / x;
+	    if (!Scale)
+		res *= std::exp(-x);
+	}
+	return (std::fabs(res) < std::numeric_limits<T>::min()) ? T(0) : res;
+    }
+}
+
+/* Incomplete gamma function G(a,x) for 'a' real and x >= 0, or
+ * e^x x^(1-a) G(a,x) when 'Scale' is true */
+template <bool Scale = false, typename T>
+inline T gamma_inc(T a, T x)
+{
+    if (std::isnan(x) || std::isnan(a))
+	return a + x;
+
+    if (x < 0)
+	return std::numeric_limits<T>::quiet_NaN();
+    else if (x == 0)
+    {
+	if (!Scale)
+	    return T(gammafn(double(a)));
+	/* limit of the scaled function as x -> 0+ */
+	return (a < 1) ? T(0) : (a == 1) ? T(1) :
+	    std::numeric_limits<T>::infinity();
+    }
+    else if (a == 0)
+	return Scale ? x * E1<true>(x) : E1(x);
+    else if (Scale)
+	return detail::gamma_inc_scaled(a, x);
+    else if (a > 0)
+	return T(detail::gamma_inc_rmath(double(a), double(x)));
+    else
+	return detail::gamma_inc_neg(a, x);
+}
+
+/*
+ *  BATCH FUNCTIONS
+ *
+ *  The iterator versions store the values for the range [first, last)
+ *  from 'd_first' on and return an iterator past the last value
+ *  stored; the range versions store the values for 'x' in 'y', which
+ *  may be 'x' itself, and throw std::length_error when 'y' is shorter
+ *  than 'x'.
+ */
+namespace detail {
+
+template <typename InRange, typename OutRange>
+inline void check_size(const InRange& x, const OutRange& y)
+{
+    if (std::size(y) < std::size(x))
+	throw std::length_error("expint: output range shorter than input");
+}
+
+} /* namespace detail */
+
+template <bool Scale = false, typename InputIt, typename OutputIt>
+inline OutputIt E1(InputIt first, InputIt last, OutputIt d_first)
+{
+    for (; first != last; ++first, ++d_first)
+	*d_first = E1<Scale>(*first);
+    return d_first;
+}
+
+template <bool Scale = false, typename InRange, typename OutRange>
+inline void E1(const InRange& x, OutRange&& y)
+{
+    detail::check_size(x, y);
+    E1<Scale>(std::begin(x), std::end(x), std::begin(y));
+}
+
+template <bool Scale = false, typename InputIt, typename OutputIt>
+inline OutputIt E2(InputIt first, InputIt last, OutputIt d_first)
+{
+    for (; first != last; ++first, ++d_first)
+	*d_first = E2<Scale>(*first);
+    return d_first;
+}
+
+template <bool Scale = false, typename InRange, typename OutRange>
+inline void E2(const InRange& x, OutRange&& y)
+{
+    detail::check_size(x, y);
+    E2<Scale>(std::begin(x), std::end(x), std::begin(y));
+}
+
+template <int N, bool Scale = false, typename InputIt, typename OutputIt>
+inline OutputIt En(InputIt first, InputIt last, OutputIt d_first)
+{
+    for (; first != last; ++first, ++d_first)
+	*d_first = En<N, Scale>(*first);
+    return d_first;
+}
+
+template <int N, bool Scale = false, typename InRange, typename OutRange>
+inline void En(const InRange& x, OutRange&& y)
+{
+    detail::check_size(x, y);
+    En<N, Scale>(std::begin(x), std::end(x), std::begin(y));
+}
+
+/* G(a,x) for a fixed 'a' and the values of 'x' */
+template <bool Scale = false, typename T, typename InputIt, typename OutputIt>
+inline OutputIt gamma_inc(T a, InputIt first, InputIt last, OutputIt d_first)
+{
+    for (; first != last; ++first, ++d_first)
+	*d_first = gamma_inc<Scale>(a, static_cast<T>(*first));
+    return d_first;
+}
+
+template <bool Scale = false, typename T, typename InRange, typename OutRange>
+inline void gamma_inc(T a, const InRange& x, OutRange&& y)
+{
+    detail::check_size(x, y);
+    gamma_inc<Scale>(a, std::begin(x), std::end(x), std::begin(y));
+}
+
+} /* namespace expint */
+
+#endif /* EXPINT_HPP */
@@ -38,6 +38,76 @@ double expint_E2(double x, int scale);
 double expint_En(double x, int order, int scale);
 double gamma_inc(double a, double x);
 
+/* G(a, x) scaled by e^x x^(1-a), and log G(a, x) (or the log of the
+ * scaled function when 'scale' is non zero), free of overflow and
+ * underflow */
+double gamma_inc_scaled(double a, double x);
+double gamma_inc_log(double a, double x, int scale);
+
+/* Same functions returning along with the value an estimate of its
+ * absolute error in 'err', propagated through the Chebyshev
+ * expansions, continued fraction and recursion (as the GSL functions
+ * returning a 'gsl_sf_result'); the values are identical */
+double expint_E1_e(double x, int scale, double *err);
+double expint_E2_e(double x, int scale, double *err);
+double expint_En_e(double x, int order, int scale, double *err);
+double gamma_inc_e(double a, double x, double *err);
+double gamma_inc_scaled_e(double a, double x, double *err);
+double gamma_inc_log_e(double a, double x, int scale, double *err);
+
+/* Inverses: the solutions 'x' of E_n(x) = y and G(a, x) = y (NaN when
+ * 'y' is out of the range of the function) */
+double expint_En_inv(double y, int n);
+double gamma_inc_inv(double a, double y);
+
+/* Batch versions: 'n' values of the first argument read with stride
+ * 'inc' (0 to recycle a single value), values of the second argument
+ * recycled, results stored contiguously in 'y' supplied by the caller
+ * (nothing is allocated, so a workspace may be reused across calls) */
+void expint_E1_vec(const double *x, R_xlen_t n, R_xlen_t incx,
+		   int scale, double *y);
+void expint_E2_vec(const double *x, R_xlen_t n, R_xlen_t incx,
+		   int scale, double *y);
+void expint_En_vec(const double *x, R_xlen_t n, R_xlen_t incx,
+		   const int *order, R_xlen_t norder, int scale, double *y);
+void gamma_inc_vec(const double *a, R_xlen_t n, R_xlen_t inca,
+		   const double *x, R_xlen_t nx, double *y);
+
+/* Exponential integrals of orders 1, ..., 'nmax' at 'x', stored in
+ * 'y' with stride 'incy' */
+void expint_En_seq(double x, int nmax, int scale, double *y, R_xlen_t incy);
+
+/* Incomplete gamma functions G(a - k, x) for k = 0, ..., K, stored
+ * in 'y' with stride 'incy' */
+void gamma_inc_ladder(double a, double x, int K, double *y, R_xlen_t incy);
+
+/* E_n(x) and its derivatives of orders 1, ..., 'nderiv' with respect
+ * to 'x', stored in 'y' with stride 'incy' */
+void expint_En_deriv(double x, int n, int nderiv, int scale,
+		     double *y, R_xlen_t incy);
+
+/* G(a, x) and its partial derivatives with respect to 'x' and 'a',
+ * stored in 'y' with stride 'incy' */
+void gamma_inc_deriv(double a, double x, double *y, R_xlen_t incy);
+
+/* Precision of the computations of the calling thread: the routines
+ * above compute to about single precision, and faster, after
+ * expint_set_precision(EXPINT_PREC_SINGLE). Returns the previous
+ * precision. */
+#define EXPINT_PREC_DOUBLE 0
+#define EXPINT_PREC_SINGLE 1
+int expint_set_precision(int precision);
+
+/* Memoization of gamma_inc() and expint_En() shared with the R
+ * functions: cache of at least 'size' values (0 to disable), emptied
+ * with expint_cache_clear(); expint_cache_info() returns the size and
+ * the numbers of hits and misses. Not to be called while other
+ * threads compute. */
+int expint_cache_enable(size_t size);
+void expint_cache_clear(void);
+void expint_cache_info(size_t *size, unsigned long long *hits,
+		       unsigned long long *misses);
+
 #ifdef  __cplusplus
 }
 #endif
@@ -0,0 +1,83 @@
+/*  == expint: Exponential Integral and Incomplete Gamma Function ==
+ *
+ *  R interface to the memoization of gamma_inc() and expint_En();
+ *  see libexpint/cache.c.
+ *
+ *  Copyright (C) 2026 Vincent Goulet
+ *
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU General Public License as
+ *  published by the Free Software Foundation; either version 3 of the
+ *  License, or (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ *  General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ *  02110-1301, USA.
+ *
+ *  AUTHOR: Vincent Goulet <vincent.goulet@act.ulaval.ca>
+ */
+
+#include <R.h>
+#include <Rinternals.h>
+#include "locale.h"
+#include "expint.h"
+
+/* Function called by .External() to set the size of the cache (0 to
+ * disable it); returns the previous size */
+SEXP expint_do_cache(SEXP args)
+{
+    size_t old;
+    unsigned long long hits, misses;
+    double size;
+
+    args = CDR(args);	       /* drop function name from arguments */
+    size = asReal(CAR(args));
+    if (ISNAN(size) || size < 0 || size > 1e9)
+        error(_("invalid arguments"));
+
+    expint_cache_info(&old, &hits, &misses);
+    if (expint_cache_enable((size_t) size) != 0)
+	error(_("cannot allocate a cache of %.0f values"), size);
+
+    return ScalarReal((double) old);
+}
+
+/* Function called by .External() to get the size of the cache and the
+ * number of hits and misses */
+SEXP expint_do_cache_stats(SEXP args)
+{
+    SEXP sy, snames;
+    size_t size;
+    unsigned long long hits, misses;
+
+    expint_cache_info(&size, &hits, &misses);
+
+    PROTECT(sy = allocVector(REALSXP, 3));
+    REAL(sy)[0] = (double) size;
+    REAL(sy)[1] = (double) hits;
+    REAL(sy)[2] = (double) misses;
+
+    PROTECT(snames = allocVector(STRSXP, 3));
+    SET_STRING_ELT(snames, 0, mkChar("size"));
+    SET_STRING_ELT(snames, 1, mkChar("hits"));
+    SET_STRING_ELT(snames, 2, mkChar("misses"));
+    setAttrib(sy, R_NamesSymbol, snames);
+
+    UNPROTECT(2);
+
+    return sy;
+}
+
+/* Function called by .External() to empty the cache */
+SEXP expint_do_cache_clear(SEXP args)
+{
+    expint_cache_clear();
+
+    return R_NilValue;
+}
@@ -1,6 +1,6 @@
 /*  == expint: Exponential Integral and Incomplete Gamma Function ==
  *
- *  Functions to compute the exponential integral functions
+ *  R interface to the functions computing the exponential integrals
  *
  *     E_1(x) = int_x^infty exp(-t)/t dt,
  *     E_2(x) = int_x^infty exp(-t)/t^2 dt
@@ -11,11 +11,7 @@
  *
  *  Copyright (C) 2016-2026 Vincent Goulet
  *
- *  The code in part IMPLEMENTATION is derived from the GNU Scientific
- *  Library (GSL) v2.2.1 <https://www.gnu.org/software/gsl/>
- *
- *  Copyright (C) 2007 Brian Gough
- *  Copyright (C) 1996, 1997, 1998, 1999, 2000, 2001, 2002 Gerard Jungman
+ *  The workhorses are in libexpint/expint.c.
  *
  *  The code in part R TO C INTERFACE is derived from R source code.
  *
@@ -38,639 +34,706 @@
  *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
  *  02110-1301, USA.
  *
- *  AUTHOR for the GSL: G. Jungman
  *  AUTHOR for expint: Vincent Goulet <vincent.goulet@act.ulaval.ca>
  *                     with much indirect help from the R Core Team
  */
 
 #include <R.h>
 #include <Rinternals.h>
-#include <Rmath.h>
 #include "locale.h"
 #include "expint.h"
 
 /* Prototypes of auxiliary functions */
-static SEXP expint1_1(SEXP, SEXP, double (*f)(double, int));
-static SEXP expint2_1(SEXP, SEXP, SEXP, double (*f)(double, int, int));
+static SEXP expint1_1(SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, int, void (*f)(const double *, double *, ptrdiff_t, int), double (*fe)(double, int, double *));
+static SEXP expint2_1(SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, SEXP, int, double (*f)(double, int, int), double (*fe)(double, int, int, double *));
+static SEXP expint_seq(SEXP, SEXP, SEXP, SEXP, void (*f)(double, int, int, double *, ptrdiff_t));
+static SEXP expint_deriv(SEXP, SEXP, SEXP, SEXP, SEXP, void (*f)(double, int, int, int, double *, ptrdiff_t));
+static SEXP expint_inv(SEXP, SEXP, SEXP, double (*f)(double, int));
 
 /*
- *  IMPLEMENTATION OF THE WORKHORSES
+ *  R TO C INTERFACE
  *
- *  Adapted from "special functions" material in the GSL.
+ *  Adapted from src/main/arithmetic.c in R sources and from a similar
+ *  scheme in package actuar. Main difference: everything is in this
+ *  one file.
  *
  */
 
-/* Data structure for a Chebyshev series over a given interval */
-struct cheb_series_struct {
-    double * c;   /* coefficients                */
-    int order;    /* order of expansion          */
-    double a;     /* lower interval point        */
-    double b;     /* upper interval point        */
-    int order_sp; /* effective single precision order */
-};
-typedef struct cheb_series_struct cheb_series;
-
-
-/*
- Chebyshev expansions: based on SLATEC e1.f, W. Fullerton
-
- Series for AE11       on the interval -1.00000D-01 to  0.
-                                        with weighted error   1.76E-17
-                                         log weighted error  16.75
-                               significant figures required  15.70
-                                    decimal places required  17.55
-
-
- Series for AE12       on the interval -2.50000D-01 to -1.00000D-01
-                                        with weighted error   5.83E-17
-                                         log weighted error  16.23
-                               significant figures required  15.76
-                                    decimal places required  16.93
-
-
- Series for E11        on the interval -4.00000D+00 to -1.00000D+00
-                                        with weighted error   1.08E-18
-                                         log weighted error  17.97
-                               significant figures required  19.02
-                                    decimal places required  18.61
-
-
- Series for E12        on the interval -1.00000D+00 to  1.00000D+00
-                                        with weighted error   3.15E-18
-                                         log weighted error  17.50
-                        approx significant figures required  15.8
-                                    decimal places required  18.10
-
-
- Series for AE13       on the interval  2.50000D-01 to  1.00000D+00
-                                        with weighted error   2.34E-17
-                                         log weighted error  16.63
-                               significant figures required  16.14
-                                    decimal places required  17.33
-
-
- Series for AE14       on the interval  0.          to  2.50000D-01
-                                        with weighted error   5.41E-17
-                                         log weighted error  16.27
-                               significant figures required  15.38
-                                    decimal places required  16.97
-*/
-
-static double AE11_data[39] = {
-   0.121503239716065790,
-  -0.065088778513550150,
-   0.004897651357459670,
-  -0.000649237843027216,
-   0.000093840434587471,
-   0.000000420236380882,
-  -0.000008113374735904,
-   0.000002804247688663,
-   0.000000056487164441,
-  -0.000000344809174450,
-   0.000000058209273578,
-   0.000000038711426349,
-  -0.000000012453235014,
-  -0.000000005118504888,
-   0.000000002148771527,
-   0.000000000868459898,
-  -0.000000000343650105,
-  -0.000000000179796603,
-   0.000000000047442060,
-   0.000000000040423282,
-  -0.000000000003543928,
-  -0.000000000008853444,
-  -0.000000000000960151,
-   0.000000000001692921,
-   0.000000000000607990,
-  -0.000000000000224338,
-  -0.000000000000200327,
-  -0.000000000000006246,
-   0.000000000000045571,
-   0.000000000000016383,
-  -0.000000000000005561,
-  -0.000000000000006074,
-  -0.000000000000000862,
-   0.000000000000001223,
-   0.000000000000000716,
-  -0.000000000000000024,
-  -0.000000000000000201,
-  -0.000000000000000082,
-   0.000000000000000017
-};
-static cheb_series AE11_cs = {
-  AE11_data,
-  38,
-  -1, 1,
-  20
-};
+/* Number of threads requested at the R level */
+int expint_nthreads(SEXP sT)
+{
+    int nthreads = asInteger(sT);
+
+    if (nthreads == NA_INTEGER || nthreads < 1)
+	return 1;
+#ifdef _OPENMP
+    return nthreads;
+#else
+    return 1;
+#endif
+}
 
-static double AE12_data[25] = {
-   0.582417495134726740,
-  -0.158348850905782750,
-  -0.006764275590323141,
-   0.005125843950185725,
-   0.000435232492169391,
-  -0.000143613366305483,
-  -0.000041801320556301,
-  -0.000002713395758640,
-   0.000001151381913647,
-   0.000000420650022012,
-   0.000000066581901391,
-   0.000000000662143777,
-  -0.000000002844104870,
-  -0.000000000940724197,
-  -0.000000000177476602,
-  -0.000000000015830222,
-   0.000000000002905732,
-   0.000000000001769356,
-   0.000000000000492735,
-   0.000000000000093709,
-   0.000000000000010707,
-  -0.000000000000000537,
-  -0.000000000000000716,
-  -0.000000000000000244,
-  -0.000000000000000058
-};
-static cheb_series AE12_cs = {
-  AE12_data,
-  24,
-  -1, 1,
-  15
-};
+/* Precision of the computations requested at the R level */
+int expint_precision(SEXP sP)
+{
+    return strcmp(CHAR(asChar(sP)), "single") == 0 ?
+	EXPINT_PREC_SINGLE : EXPINT_PREC_DOUBLE;
+}
 
-static double E11_data[19] = {
-  -16.11346165557149402600,
-    7.79407277874268027690,
-   -1.95540581886314195070,
-    0.37337293866277945612,
-   -0.05692503191092901938,
-    0.00721107776966009185,
-   -0.00078104901449841593,
-    0.00007388093356262168,
-   -0.00000620286187580820,
-    0.00000046816002303176,
-   -0.00000003209288853329,
-    0.00000000201519974874,
-   -0.00000000011673686816,
-    0.00000000000627627066,
-   -0.00000000000031481541,
-    0.00000000000001479904,
-   -0.00000000000000065457,
-    0.00000000000000002733,
-   -0.00000000000000000108
-};
-static cheb_series E11_cs = {
-  E11_data,
-  18,
-  -1, 1,
-  13
-};
+/* Status vector of the elements of the result when requested at the
+ * R level; NULL otherwise. The vector is allocated, protected and
+ * returned in 'sst'. */
+int *expint_status_vector(SEXP sS, R_xlen_t n, SEXP *sst)
+{
+    if (asLogical(sS) != TRUE)
+	return NULL;
 
-static double E12_data[16] = {
-  -0.03739021479220279500,
-   0.04272398606220957700,
-  -0.13031820798497005440,
-   0.01441912402469889073,
-  -0.00134617078051068022,
-   0.00010731029253063780,
-  -0.00000742999951611943,
-   0.00000045377325690753,
-  -0.00000002476417211390,
-   0.00000000122076581374,
-  -0.00000000005485141480,
-   0.00000000000226362142,
-  -0.00000000000008635897,
-   0.00000000000000306291,
-  -0.00000000000000010148,
-   0.00000000000000000315
-};
-static cheb_series E12_cs = {
-  E12_data,
-  15,
-  -1, 1,
-  10
-};
+    PROTECT(*sst = allocVector(INTSXP, n));
+    memset(INTEGER(*sst), 0, n * sizeof(int));
+    return INTEGER(*sst);
+}
 
-static double AE13_data[25] = {
-  -0.605773246640603460,
-  -0.112535243483660900,
-   0.013432266247902779,
-  -0.001926845187381145,
-   0.000309118337720603,
-  -0.000053564132129618,
-   0.000009827812880247,
-  -0.000001885368984916,
-   0.000000374943193568,
-  -0.000000076823455870,
-   0.000000016143270567,
-  -0.000000003466802211,
-   0.000000000758754209,
-  -0.000000000168864333,
-   0.000000000038145706,
-  -0.000000000008733026,
-   0.000000000002023672,
-  -0.000000000000474132,
-   0.000000000000112211,
-  -0.000000000000026804,
-   0.000000000000006457,
-  -0.000000000000001568,
-   0.000000000000000383,
-  -0.000000000000000094,
-   0.000000000000000023
-};
-static cheb_series AE13_cs = {
-  AE13_data,
-  24,
-  -1, 1,
-  15
-};
+/* Vector of the estimates of the absolute error of the elements of
+ * the result when requested at the R level; NULL otherwise. The
+ * vector is allocated, protected and returned in 'serr'. */
+double *expint_error_vector(SEXP sE, R_xlen_t n, SEXP *serr)
+{
+    if (asLogical(sE) != TRUE)
+	return NULL;
 
-static double AE14_data[26] = {
-  -0.18929180007530170,
-  -0.08648117855259871,
-   0.00722410154374659,
-  -0.00080975594575573,
-   0.00010999134432661,
-  -0.00001717332998937,
-   0.00000298562751447,
-  -0.00000056596491457,
-   0.00000011526808397,
-  -0.00000002495030440,
-   0.00000000569232420,
-  -0.00000000135995766,
-   0.00000000033846628,
-  -0.00000000008737853,
-   0.00000000002331588,
-  -0.00000000000641148,
-   0.00000000000181224,
-  -0.00000000000052538,
-   0.00000000000015592,
-  -0.00000000000004729,
-   0.00000000000001463,
-  -0.00000000000000461,
-   0.00000000000000148,
-  -0.00000000000000048,
-   0.00000000000000016,
-  -0.00000000000000005
-};
-static cheb_series AE14_cs = {
-  AE14_data,
-  25,
-  -1, 1,
-  13
-};
+    PROTECT(*serr = allocVector(REALSXP, n));
+    return REAL(*serr);
+}
 
-/* Adapted from specfun/cheb_eval.c in GSL sources */
-static inline double cheb_eval(const cheb_series * cs,
-				 const double x)
+/* Storage for the 'n' values of the result: the double vector 'sO'
+ * supplied at the R level, from element 'offset' (a whole number),
+ * when there is one;
+ * a new vector otherwise. The vector is protected and returned in
+ * 'sy'. Status and error vectors cannot be attached to a supplied
+ * vector. */
+double *expint_result_vector(SEXP sO, SEXP sOff, SEXP sS, SEXP sE,
+			     R_xlen_t n, SEXP *sy)
 {
-    int j;
-    double d  = 0.0;
-    double dd = 0.0;
+    double offset;
 
-    double y  = (2.0*x - cs->a - cs->b) / (cs->b - cs->a);
-    double y2 = 2.0 * y;
-
-    for(j = cs->order; j >= 1; j--)
+    if (isNull(sO))
     {
-	double temp = d;
-	d = y2*d - dd + cs->c[j];
-	dd = temp;
+	PROTECT(*sy = allocVector(REALSXP, n));
+	return REAL(*sy);
     }
 
-    return y*d - dd + 0.5 * cs->c[0];
+    offset = asReal(sOff);
+    if (TYPEOF(sO) != REALSXP || ISNAN(offset) || offset < 0 ||
+	offset != floor(offset) || offset + n > XLENGTH(sO))
+	error(_("invalid 'out' argument"));
+    if (asLogical(sS) == TRUE)
+	error(_("'out' cannot be used with 'status = TRUE'"));
+    if (asLogical(sE) == TRUE)
+	error(_("'out' cannot be used with 'error = TRUE'"));
+
+    PROTECT(*sy = sO);
+    return REAL(sO) + (R_xlen_t) offset;
 }
 
-/* Adapted from specfun/expint.c::expint_E1_impl in GSL sources */
-double expint_E1(double x, int scale)
+/* Functions to handle cases with one argument (REAL) and an integer
+ * flag. The argument is read by blocks of EXPINT_BLOCK values, without
+ * coercion of the whole vector. The values of a block are computed by
+ * a batch routine, in parallel over chunks of EXPINT_CHUNK values when
+ * more than one thread is requested. When the status of each element
+ * is requested, the batch routine is called one element at a time;
+ * when the estimates of the error are requested, the scalar routine
+ * 'fe' is called instead.
+ * The precision is set per thread, hence at the beginning of each
+ * chunk, and restored at the end.
+ *
+ * When deduplication is requested, the function is evaluated at the
+ * distinct values of 'x' only, and the results scattered back.
+ *
+ * A lazy result, computed on access, is returned on request unless
+ * the status, the error or deduplication is also requested, or the
+ * results go to a vector 'sO' supplied by the caller; 'lazy'
+ * identifies the function. */
+static SEXP expint1_1(SEXP sx, SEXP sI, SEXP sS, SEXP sE, SEXP sT, SEXP sP,
+		      SEXP sU, SEXP sL, SEXP sO, SEXP sOff, int lazy,
+		      void (*f)(const double *, double *, ptrdiff_t, int),
+		      double (*fe)(double, int, double *))
 {
-#ifdef IEEE_754
-    if (ISNAN(x))
-	return x;
-#endif
+    SEXP sy, sst = R_NilValue, serr = R_NilValue;
+    R_xlen_t b, i, nx, nchunks, m, *map, *first;
+    double *x, *y, *e;
+    int *st, naflag = 0;
+
+    if (!isNumeric(sx))
+        error(_("invalid arguments"));
 
-    const double xmaxt = -LOG_DBL_MIN;       /* XMAXT = -LOG(DBL_MIN) */
-    const double xmax  = xmaxt - log(xmaxt); /* XMAX = XMAXT - LOG(XMAXT) */
+    nx = XLENGTH(sx);
+    if (nx == 0)
+        return isNull(sO) ? allocVector(REALSXP, 0) : sO;
 
-    if (x < -xmax && !scale)
+    if (asLogical(sL) == TRUE && asLogical(sS) != TRUE &&
+	asLogical(sE) != TRUE && asLogical(sU) != TRUE && isNull(sO))
     {
-	warning(_("overflow in expint_E1"));
-	return R_PosInf;
+	PROTECT(sy = expint_lazy(lazy, sx, R_NilValue, asInteger(sI),
+				 expint_precision(sP)));
+	SHALLOW_DUPLICATE_ATTRIB(sy, sx);
+	UNPROTECT(1);
+	return sy;
     }
-    else if (x <= -10.0)
+
+    PROTECT(sx = expint_real_or_integer(sx));
+    y = expint_result_vector(sO, sOff, sS, sE, nx, &sy);
+
+    if (asLogical(sU) == TRUE &&
+	(m = expint_unique(sx, R_NilValue, nx, &map, &first)) >= 0)
     {
-	const double s = 1.0/x * (scale ? 1.0 : exp(-x));
-	const double cheb = cheb_eval(&AE11_cs, 20.0/x+1.0);
-	return s * (1.0 + cheb);
+	SEXP sux, suy;
+	PROTECT(sux = allocVector(REALSXP, m));
+	for (i = 0; i < m; i++)
+	    REAL(sux)[i] = expint_real_elt(sx, first[i]);
+	PROTECT(suy = expint1_1(sux, sI, sS, sE, sT, sP, R_NilValue,
+				R_NilValue, R_NilValue, R_NilValue, lazy,
+				f, fe));
+	expint_scatter(suy, nx, map, isNull(sO) ? sx : R_NilValue, sy, y);
+	UNPROTECT(4);
+	return sy;
     }
-    else if (x <= -4.0)
+    x = (double *) R_alloc(EXPINT_BLOCK, sizeof(double));
+
+    int i_1 = asInteger(sI);
+    int nthreads = expint_nthreads(sT);
+    int prec = expint_precision(sP);
+    st = expint_status_vector(sS, nx, &sst);
+    e = expint_error_vector(sE, nx, &serr);
+
+    /* NA and NaN values are passed through by the batch routines */
+    expint_defer_signals();
+    for (b = 0; b < nx; b += EXPINT_BLOCK)
     {
-	const double s = 1.0/x * (scale ? 1.0 : exp(-x));
-	const double cheb = cheb_eval(&AE12_cs, (40.0/x+7.0)/3.0);
-	return s * (1.0 + cheb);
+	R_xlen_t nb = (nx - b < EXPINT_BLOCK) ? nx - b : EXPINT_BLOCK;
+
+	expint_read_real(sx, b, nb, x);
+	nchunks = (nb + EXPINT_CHUNK - 1) / EXPINT_CHUNK;
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nthreads) schedule(dynamic, 1) \
+    reduction(||:naflag) if (nthreads > 1)
+#endif
+	for (i = 0; i < nchunks; i++)
+	{
+	    R_xlen_t j, start = i * EXPINT_CHUNK;
+	    R_xlen_t len = (nb - start < EXPINT_CHUNK) ? nb - start : EXPINT_CHUNK;
+	    double *yb = y + b;
+	    int oprec = expint_set_precision(prec);
+
+	    if (st == NULL && e == NULL)
+		f(x + start, yb + start, len, i_1);
+	    else
+	    {
+		expint_take_status();
+		for (j = start; j < start + len; j++)
+		{
+		    if (e == NULL)
+			f(x + j, yb + j, 1, i_1);
+		    else
+			yb[j] = fe(x[j], i_1, e + b + j);
+		    if (st != NULL) st[b + j] = expint_take_status();
+		}
+	    }
+	    for (j = start; j < start + len; j++)
+		if (ISNAN(yb[j]) && !ISNAN(x[j])) naflag = 1;
+	    expint_set_precision(oprec);
+	    expint_collect_signals();
+	}
     }
-    else if (x <= -1.0)
+    expint_flush_signals();
+
+    if (naflag)
+        warning(R_MSG_NA);
+
+    if (isNull(sO))
+	SHALLOW_DUPLICATE_ATTRIB(sy, sx);
+    if (st != NULL)
     {
-	const double s = (scale ? exp(x) : 1.0);
-	const double ln_term = -log(fabs(x));
-	const double cheb = cheb_eval(&E11_cs, (2.0*x+5.0)/3.0);
-	return s * (ln_term + cheb);
+	setAttrib(sy, install("status"), sst);
+	UNPROTECT(1);
     }
-    else if (x == 0.0)
+    if (e != NULL)
     {
-	return R_NaN;
+	setAttrib(sy, install("error"), serr);
+	UNPROTECT(1);
     }
-    else if (x <= 1.0)
+    UNPROTECT(2);
+
+    return sy;
+}
+
+#define EXPINT1_1(A, LAZY, FUN, FUN_E) expint1_1(CAR(A), CADR(A), CADDR(A), CAD4R(CDDR(CDDDR(A))), CADDDR(A), CAD4R(A), CAD4R(CDR(A)), CAD4R(CDDR(A)), CAD4R(CDDDR(A)), CAD4R(CDR(CDDDR(A))), LAZY, FUN, FUN_E);
+
+SEXP expint_do_expint1(int code, SEXP args)
+{
+    switch (code)
     {
-	const double s = (scale ? exp(x) : 1.0);
-	const double ln_term = -log(fabs(x));
-	const double cheb = cheb_eval(&E12_cs, x);
-	return s * (ln_term - 0.6875 + x + cheb);
+    case 1: return EXPINT1_1(args, EXPINT_LAZY_E1, expint_E1_batch, expint_E1_e);
+    case 2: return EXPINT1_1(args, EXPINT_LAZY_E2, expint_E2_batch, expint_E2_e);
+    default:
+        error(_("internal error in expint_do_expint1"));
     }
-    else if (x <= 4.0)
+
+    return args;                /* never used; to keep -Wall happy */
+}
+
+/* Functions to handle cases with two arguments (REAL and INTEGER) and
+ * an integer flag. The arguments are read, recycled, by blocks of
+ * EXPINT_BLOCK values, and the chunks of EXPINT_CHUNK values of a
+ * block are processed in parallel; the cost per element varies with
+ * the order, hence the dynamic schedule. Deduplication is over the
+ * pairs of recycled arguments; lazy results, results stored in 'sO'
+ * and estimates of the error (computed by 'fe') are as above. */
+static SEXP expint2_1(SEXP sx, SEXP sa, SEXP sI, SEXP sS, SEXP sE, SEXP sT,
+		      SEXP sP, SEXP sU, SEXP sL, SEXP sO, SEXP sOff, int lazy,
+		      double (*f)(double, int, int),
+		      double (*fe)(double, int, int, double *))
+{
+    SEXP sy, sst = R_NilValue, serr = R_NilValue;
+    R_xlen_t b, c, n, nx, na, nchunks, m, *map, *first;
+    double *x, *a, *y, *e;
+    int *st, naflag = 0, intflag = 0;
+
+    if (!isNumeric(sx) || !isNumeric(sa))
+        error(_("invalid arguments"));
+
+    nx = XLENGTH(sx);
+    na = XLENGTH(sa);
+    if ((nx == 0) || (na == 0))
+        return isNull(sO) ? allocVector(REALSXP, 0) : sO;
+
+    n = (nx < na) ? na : nx;
+
+    if (asLogical(sL) == TRUE && asLogical(sS) != TRUE &&
+	asLogical(sE) != TRUE && asLogical(sU) != TRUE && isNull(sO))
     {
-	const double s = 1.0/x * (scale ? 1.0 : exp(-x));
-	const double cheb = cheb_eval(&AE13_cs, (8.0/x-5.0)/3.0);
-	return s * (1.0 + cheb);
+	PROTECT(sy = expint_lazy(lazy, sx, sa, asInteger(sI),
+				 expint_precision(sP)));
+	if (n == nx)
+	    SHALLOW_DUPLICATE_ATTRIB(sy, sx);
+	else if (n == na)
+	    SHALLOW_DUPLICATE_ATTRIB(sy, sa);
+	UNPROTECT(1);
+	return sy;
     }
-    else if (x <= xmax || scale)
+
+    PROTECT(sx = expint_real_or_integer(sx));
+    PROTECT(sa = expint_real_or_integer(sa));
+    y = expint_result_vector(sO, sOff, sS, sE, n, &sy);
+
+    if (asLogical(sU) == TRUE &&
+	(m = expint_unique(sx, sa, n, &map, &first)) >= 0)
     {
-	const double s = 1.0/x * (scale ? 1.0 : exp(-x));
-	const double cheb = cheb_eval(&AE14_cs, 8.0/x-1.0);
-	double res = s * (1.0 +  cheb);
-	if (res == 0.0)
+	SEXP sux, sua, suy;
+	PROTECT(sux = allocVector(REALSXP, m));
+	PROTECT(sua = allocVector(REALSXP, m));
+	for (c = 0; c < m; c++)
 	{
-	    warning(_("underflow in expint_E1"));
-	    return 0.0;
+	    REAL(sux)[c] = expint_real_elt(sx, first[c] % nx);
+	    REAL(sua)[c] = expint_real_elt(sa, first[c] % na);
 	}
-	else
-	    return res;
-    }
-    else {
-	warning(_("underflow in expint_E1"));
-	return 0.0;
+	PROTECT(suy = expint2_1(sux, sua, sI, sS, sE, sT, sP, R_NilValue,
+				R_NilValue, R_NilValue, R_NilValue, lazy,
+				f, fe));
+	expint_scatter(suy, n, map,
+		       !isNull(sO) ? R_NilValue :
+		       (n == nx) ? sx : (n == na) ? sa : R_NilValue, sy, y);
+	UNPROTECT(6);
+	return sy;
     }
-}
 
-/* Adapted from specfun/expint.c::expint_E2_impl in GSL sources */
-double expint_E2(double x, int scale)
-{
-#ifdef IEEE_754
-    if (ISNAN(x))
-	return x;
-#endif
+    x = (double *) R_alloc(EXPINT_BLOCK, sizeof(double));
+    a = (double *) R_alloc(EXPINT_BLOCK, sizeof(double));
 
-    const double xmaxt = -LOG_DBL_MIN;
-    const double xmax  = xmaxt - log(xmaxt);
+    int i_1 = asInteger(sI);
+    int nthreads = expint_nthreads(sT);
+    int prec = expint_precision(sP);
+    st = expint_status_vector(sS, n, &sst);
+    e = expint_error_vector(sE, n, &serr);
 
-    if (x < -xmax && !scale)
+    expint_defer_signals();
+    for (b = 0; b < n; b += EXPINT_BLOCK)
     {
-	warning(_("overflow in expint_E2"));
-	return R_PosInf;
+	R_xlen_t nb = (n - b < EXPINT_BLOCK) ? n - b : EXPINT_BLOCK;
+
+	expint_read_real(sx, b, nb, x);
+	expint_read_real(sa, b, nb, a);
+	nchunks = (nb + EXPINT_CHUNK - 1) / EXPINT_CHUNK;
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nthreads) schedule(dynamic, 1) \
+    reduction(||:naflag, intflag) if (nthreads > 1)
+#endif
+	for (c = 0; c < nchunks; c++)
+	{
+	    R_xlen_t i, end = (c + 1) * EXPINT_CHUNK;
+	    double xi, *yb = y + b;
+	    int ai, oprec = expint_set_precision(prec);
+
+	    if (end > nb) end = nb;
+	    expint_take_status();
+	    for (i = c * EXPINT_CHUNK; i < end; i++)
+	    {
+		xi = x[i];
+		ai = expint_order(a[i]);
+		if (ai == NA_INTEGER && !ISNAN(a[i])) intflag = 1;
+		if (ISNA(xi) || ai == NA_INTEGER)
+		{
+		    yb[i] = NA_REAL;
+		    if (e != NULL) e[b + i] = NA_REAL;
+		}
+		else if (ISNAN(xi))
+		{
+		    yb[i] = R_NaN;
+		    if (e != NULL) e[b + i] = R_NaN;
+		}
+		else
+		{
+		    if (e != NULL)
+			yb[i] = fe(xi, ai, i_1, e + b + i);
+		    else if (ai == 1)
+			yb[i] = expint_E1(xi, i_1);
+		    else if (ai == 2)
+			yb[i] = expint_E2(xi, i_1);
+		    else
+			yb[i] = f(xi, ai, i_1);
+		    if (ISNAN(yb[i])) naflag = 1;
+		    if (st != NULL) st[b + i] = expint_take_status();
+		}
+	    }
+	    expint_set_precision(oprec);
+	    expint_collect_signals();
+	}
     }
-    else if (x == 0.0)
+    expint_flush_signals();
+
+    if (intflag)
+        warning(R_MSG_NA_INT);
+    if (naflag)
+        warning(R_MSG_NA);
+
+    if (isNull(sO))
     {
-	return 1.0;
+	if (n == nx)
+	    SHALLOW_DUPLICATE_ATTRIB(sy, sx);
+	else if (n == na)
+	    SHALLOW_DUPLICATE_ATTRIB(sy, sa);
     }
-    else if (x < 100.0)
+    if (st != NULL)
     {
-	const double ex = (scale ? 1.0 : exp(-x));
-	return ex - x * expint_E1(x, scale);
+	setAttrib(sy, install("status"), sst);
+	UNPROTECT(1);
     }
-    else if (x < xmax || scale)
+    if (e != NULL)
     {
-	const double s = (scale ? 1.0 : exp(-x));
-	const double c1  = -2.0;
-	const double c2  =  6.0;
-	const double c3  = -24.0;
-	const double c4  =  120.0;
-	const double c5  = -720.0;
-	const double c6  =  5040.0;
-	const double c7  = -40320.0;
-	const double c8  =  362880.0;
-	const double c9  = -3628800.0;
-	const double c10 =  39916800.0;
-	const double c11 = -479001600.0;
-	const double c12 =  6227020800.0;
-	const double c13 = -87178291200.0;
-	const double y = 1.0/x;
-	const double sum6 = c6+y*(c7+y*(c8+y*(c9+y*(c10+y*(c11+y*(c12+y*c13))))));
-	const double sum  = y*(c1+y*(c2+y*(c3+y*(c4+y*(c5+y*sum6)))));
-	double res = s * (1.0 + sum)/x;
-	if (res == 0.0)
-	{
-	    warning(_("underflow in expint_E2"));
-	    return 0.0;
-	}
-	else
-	    return res;
-    }
-    else {
-	warning(_("underflow in expint_E2"));
-	return 0.0;
+	setAttrib(sy, install("error"), serr);
+	UNPROTECT(1);
     }
+
+    UNPROTECT(3);
+
+    return sy;
 }
 
-/* Macro used in expint_En (only) */
-#define CHECK_UNDERFLOW(x)			\
-    if (fabs(x) < DBL_MIN) {			\
-        warning(_("underflow in expint_En"));	\
-	return 0.0;				\
-    }						\
+#define EXPINT2_1(A, LAZY, FUN, FUN_E) expint2_1(CAR(A), CADR(A), CADDR(A), CADDDR(A), CAD4R(CDDDR(CDDDR(A))), CAD4R(A), CAD4R(CDR(A)), CAD4R(CDDR(A)), CAD4R(CDDDR(A)), CAD4R(CDR(CDDDR(A))), CAD4R(CDDR(CDDDR(A))), LAZY, FUN, FUN_E);
 
-/* Adapted from specfun/expint.c::expint_En_impl in GSL sources */
-double expint_En(double x, int n, int scale)
+SEXP expint_do_expint2(int code, SEXP args)
 {
-#ifdef IEEE_754
-    if (ISNAN(x))
-	return x;
-#endif
+    switch (code)
+    {
+    case 1: return EXPINT2_1(args, EXPINT_LAZY_EN, expint_En, expint_En_e);
+    default:
+        error(_("internal error in expint_do_expint2"));
+    }
+
+    return args;                /* never used; to keep -Wall happy */
+}
+
+/* Function to handle the sequence of exponential integrals of orders
+ * 1, ..., nmax at each value of a vector: the result is a matrix
+ * with one row per value. The values are read by blocks of
+ * EXPINT_BLOCK values. */
+static SEXP expint_seq(SEXP sx, SEXP sN, SEXP sI, SEXP sT,
+		       void (*f)(double, int, int, double *, ptrdiff_t))
+{
+    SEXP sy, names;
+    R_xlen_t b, i, nx, nchunks;
+    double *x, *y;
+    int nmax, naflag = 0;
+
+    if (!isNumeric(sx) || !isNumeric(sN))
+        error(_("invalid arguments"));
 
-    if (n < 0)
-	return R_NaN;
-    else if (n == 0)
+    nmax = asInteger(sN);
+    if (nmax == NA_INTEGER || nmax < 0)
+        error(_("invalid arguments"));
+
+    nx = XLENGTH(sx);
+    PROTECT(sx = expint_real_or_integer(sx));
+    PROTECT(sy = allocMatrix(REALSXP, nx, nmax));
+    x = (double *) R_alloc(EXPINT_BLOCK, sizeof(double));
+    y = REAL(sy);
+
+    int i_1 = asInteger(sI);
+    int nthreads = expint_nthreads(sT);
+
+    expint_defer_signals();
+    for (b = 0; b < nx; b += EXPINT_BLOCK)
     {
-	if (x == 0)
-	    return R_NaN;
-	else
+	R_xlen_t nb = (nx - b < EXPINT_BLOCK) ? nx - b : EXPINT_BLOCK;
+
+	expint_read_real(sx, b, nb, x);
+	nchunks = (nb + EXPINT_CHUNK - 1) / EXPINT_CHUNK;
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nthreads) schedule(dynamic, 1) \
+    reduction(||:naflag) if (nthreads > 1)
+#endif
+	for (i = 0; i < nchunks; i++)
 	{
-	    double res = (scale ? 1.0 : exp(-x)) / x;
-	    CHECK_UNDERFLOW(res);
-	    return res;
+	    R_xlen_t j, k, end = (i + 1) * EXPINT_CHUNK;
+	    double *yb = y + b;
+
+	    if (end > nb) end = nb;
+	    for (j = i * EXPINT_CHUNK; j < end; j++)
+	    {
+		if (ISNA(x[j]))
+		{
+		    for (k = 0; k < nmax; k++)
+			yb[j + k * nx] = NA_REAL;
+		    continue;
+		}
+		f(x[j], nmax, i_1, yb + j, nx);
+		if (!ISNAN(x[j]))
+		    for (k = 0; k < nmax; k++)
+			if (ISNAN(yb[j + k * nx])) naflag = 1;
+	    }
+	    expint_collect_signals();
 	}
     }
-    else if (n == 1)
-	return expint_E1(x, scale);
-    else if (n == 2)
-	return expint_E2(x, scale);
-    else
+    expint_flush_signals();
+
+    if (naflag)
+        warning(R_MSG_NA);
+
+    names = getAttrib(sx, R_NamesSymbol);
+    if (!isNull(names))
     {
-	if (x < 0)
-	    return R_NaN;
-	if (x == 0)
-	{
-	    double res = (scale ? exp(x) : 1 ) * (1/(n-1.0));
-	    CHECK_UNDERFLOW(res);
-	    return res;
-	}
-	else
-	{
-	    double s = (scale ? exp(x) : 1.0);
-	    double res = gamma_inc((double) 1 - n, x);
-	    res *= s * R_pow_di(x, n - 1);
-	    CHECK_UNDERFLOW(res);
-	    return res;
-	}
+	SEXP dn;
+	PROTECT(dn = allocVector(VECSXP, 2));
+	SET_VECTOR_ELT(dn, 0, names);
+	setAttrib(sy, R_DimNamesSymbol, dn);
+	UNPROTECT(1);
     }
+
+    UNPROTECT(2);
+
+    return sy;
 }
 
+#define EXPINT_SEQ(A, FUN) expint_seq(CAR(A), CADR(A), CADDR(A), CADDDR(A), FUN);
 
-/*
- *  R TO C INTERFACE
- *
- *  Adapted from src/main/arithmetic.c in R sources and from a similar
- *  scheme in package actuar. Main difference: everything is in this
- *  one file.
- *
- */
+SEXP expint_do_expint_seq(int code, SEXP args)
+{
+    switch (code)
+    {
+    case 1: return EXPINT_SEQ(args, expint_En_seq);
+    default:
+        error(_("internal error in expint_do_expint_seq"));
+    }
 
-/* Functions to handle cases with one argument (REAL) and an integer
- * flag */
-static SEXP expint1_1(SEXP sx, SEXP sI, double (*f)(double, int))
+    return args;                /* never used; to keep -Wall happy */
+}
+
+/* Function to handle the exponential integral of order 'order' and
+ * its derivatives of orders 1, ..., nderiv at each value of a vector:
+ * the result is a matrix with one row per value. The values are read
+ * by blocks of EXPINT_BLOCK values. */
+static SEXP expint_deriv(SEXP sx, SEXP sN, SEXP sD, SEXP sI, SEXP sT,
+			 void (*f)(double, int, int, int, double *, ptrdiff_t))
 {
-    SEXP sy;
-    R_xlen_t i, nx;
-    double xi, *x, *y;
-    Rboolean naflag = FALSE;
+    SEXP sy, names;
+    R_xlen_t b, i, nx, nchunks;
+    double *x, *y;
+    int n, nderiv, naflag = 0;
 
-    if (!isNumeric(sx))
+    if (!isNumeric(sx) || !isNumeric(sN) || !isNumeric(sD))
+        error(_("invalid arguments"));
+
+    n = asInteger(sN);
+    nderiv = asInteger(sD);
+    if (n == NA_INTEGER || nderiv == NA_INTEGER || nderiv < 0)
         error(_("invalid arguments"));
 
     nx = XLENGTH(sx);
-    if (nx == 0)
-        return(allocVector(REALSXP, 0));
-    PROTECT(sx = coerceVector(sx, REALSXP));
-    PROTECT(sy = allocVector(REALSXP, nx));
-    x = REAL(sx);
+    PROTECT(sx = expint_real_or_integer(sx));
+    PROTECT(sy = allocMatrix(REALSXP, nx, nderiv + 1));
+    x = (double *) R_alloc(EXPINT_BLOCK, sizeof(double));
     y = REAL(sy);
 
     int i_1 = asInteger(sI);
+    int nthreads = expint_nthreads(sT);
 
-    for (i = 0; i < nx; i++)
+    expint_defer_signals();
+    for (b = 0; b < nx; b += EXPINT_BLOCK)
     {
-        xi = x[i];
-	if (ISNA(xi))
-	    y[i] = NA_REAL;
-        else if (ISNAN(xi))
-	    y[i] = R_NaN;
-        else
-        {
-            y[i] = f(xi, i_1);
-            if (ISNAN(y[i])) naflag = TRUE;
-        }
+	R_xlen_t nb = (nx - b < EXPINT_BLOCK) ? nx - b : EXPINT_BLOCK;
+
+	expint_read_real(sx, b, nb, x);
+	nchunks = (nb + EXPINT_CHUNK - 1) / EXPINT_CHUNK;
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nthreads) schedule(dynamic, 1) \
+    reduction(||:naflag) if (nthreads > 1)
+#endif
+	for (i = 0; i < nchunks; i++)
+	{
+	    R_xlen_t j, k, end = (i + 1) * EXPINT_CHUNK;
+	    double *yb = y + b;
+
+	    if (end > nb) end = nb;
+	    for (j = i * EXPINT_CHUNK; j < end; j++)
+	    {
+		if (ISNA(x[j]))
+		{
+		    for (k = 0; k <= nderiv; k++)
+			yb[j + k * nx] = NA_REAL;
+		    continue;
+		}
+		f(x[j], n, nderiv, i_1, yb + j, nx);
+		if (!ISNAN(x[j]))
+		    for (k = 0; k <= nderiv; k++)
+			if (ISNAN(yb[j + k * nx])) naflag = 1;
+	    }
+	    expint_collect_signals();
+	}
     }
+    expint_flush_signals();
 
     if (naflag)
         warning(R_MSG_NA);
 
-    SHALLOW_DUPLICATE_ATTRIB(sy, sx);
+    names = getAttrib(sx, R_NamesSymbol);
+    if (!isNull(names))
+    {
+	SEXP dn;
+	PROTECT(dn = allocVector(VECSXP, 2));
+	SET_VECTOR_ELT(dn, 0, names);
+	setAttrib(sy, R_DimNamesSymbol, dn);
+	UNPROTECT(1);
+    }
+
     UNPROTECT(2);
 
     return sy;
 }
 
-#define EXPINT1_1(A, FUN) expint1_1(CAR(A), CADR(A), FUN);
+#define EXPINT_DERIV(A, FUN) expint_deriv(CAR(A), CADR(A), CADDR(A), CADDDR(A), CAD4R(A), FUN);
 
-SEXP expint_do_expint1(int code, SEXP args)
+SEXP expint_do_expint_deriv(int code, SEXP args)
 {
     switch (code)
     {
-    case 1: return EXPINT1_1(args, expint_E1);
-    case 2: return EXPINT1_1(args, expint_E2);
+    case 1: return EXPINT_DERIV(args, expint_En_deriv);
     default:
-        error(_("internal error in expint_do_expint1"));
+        error(_("internal error in expint_do_expint_deriv"));
     }
 
     return args;                /* never used; to keep -Wall happy */
 }
 
-/* Functions to handle cases with two arguments (REAL and INTEGER) and
- * an integer flag */
-#define mod_iterate2(n1, n2, i1, i2)            \
-        for (i = i1 = i2 = 0; i < n;            \
-             i1 = (++i1 == n1) ? 0 : i1,        \
-             i2 = (++i2 == n2) ? 0 : i2,        \
-             ++i)
-
-static SEXP expint2_1(SEXP sx, SEXP sa, SEXP sI, double (*f)(double, int, int))
+/* Function to handle the inverse of the exponential integral: the
+ * solutions 'x' of E_n(x) = y for the vectors 'sy' and 'sn', read by
+ * blocks and recycled like the arguments of expint(). */
+static SEXP expint_inv(SEXP sy, SEXP sn, SEXP sT, double (*f)(double, int))
 {
-    SEXP sy;
-    R_xlen_t i, ix, ia, n, nx, na;
-    double xi, *x, *y;
-    int ai, *a;
-    Rboolean naflag = FALSE;
+    SEXP sx;
+    R_xlen_t b, c, n, ny, nn, nchunks;
+    double *y, *order, *x;
+    int naflag = 0, intflag = 0;
 
-    if (!isNumeric(sx) || !isNumeric(sa))
+    if (!isNumeric(sy) || !isNumeric(sn))
         error(_("invalid arguments"));
 
-    nx = XLENGTH(sx);
-    na = XLENGTH(sa);
-    if ((nx == 0) || (na == 0))
+    ny = XLENGTH(sy);
+    nn = XLENGTH(sn);
+    if ((ny == 0) || (nn == 0))
         return(allocVector(REALSXP, 0));
 
-    n = (nx < na) ? na : nx;
-
-    PROTECT(sx = coerceVector(sx, REALSXP));
-    PROTECT(sa = coerceVector(sa, INTSXP));
-    PROTECT(sy = allocVector(REALSXP, n));
+    n = (ny < nn) ? nn : ny;
+    PROTECT(sy = expint_real_or_integer(sy));
+    PROTECT(sn = expint_real_or_integer(sn));
+    PROTECT(sx = allocVector(REALSXP, n));
+    y = (double *) R_alloc(EXPINT_BLOCK, sizeof(double));
+    order = (double *) R_alloc(EXPINT_BLOCK, sizeof(double));
     x = REAL(sx);
-    a = INTEGER(sa);
-    y = REAL(sy);
 
-    int i_1 = asInteger(sI);
+    int nthreads = expint_nthreads(sT);
 
-    mod_iterate2(nx, na, ix, ia)
+    expint_defer_signals();
+    for (b = 0; b < n; b += EXPINT_BLOCK)
     {
-        xi = x[ix];
-        ai = a[ia];
-	if (ISNA(xi) || ai == NA_INTEGER)
-	    y[i] = NA_REAL;
-        else if (ISNAN(xi))
-	    y[i] = R_NaN;
-        else
-        {
-	    if (ai == 1)
-		y[i] = expint_E1(xi, i_1);
-	    else if (ai == 2)
-		y[i] = expint_E2(xi, i_1);
-	    else
-		y[i] = f(xi, ai, i_1);
-	    if (ISNAN(y[i])) naflag = TRUE;
-        }
+	R_xlen_t nb = (n - b < EXPINT_BLOCK) ? n - b : EXPINT_BLOCK;
+
+	expint_read_real(sy, b, nb, y);
+	expint_read_real(sn, b, nb, order);
+	nchunks = (nb + EXPINT_CHUNK - 1) / EXPINT_CHUNK;
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nthreads) schedule(dynamic, 1) \
+    reduction(||:naflag, intflag) if (nthreads > 1)
+#endif
+	for (c = 0; c < nchunks; c++)
+	{
+	    R_xlen_t i, end = (c + 1) * EXPINT_CHUNK;
+	    double yi, *xb = x + b;
+	    int ni;
+
+	    if (end > nb) end = nb;
+	    for (i = c * EXPINT_CHUNK; i < end; i++)
+	    {
+		yi = y[i];
+		ni = expint_order(order[i]);
+		if (ni == NA_INTEGER && !ISNAN(order[i])) intflag = 1;
+		if (ISNA(yi) || ni == NA_INTEGER)
+		    xb[i] = NA_REAL;
+		else if (ISNAN(yi))
+		    xb[i] = R_NaN;
+		else
+		{
+		    xb[i] = f(yi, ni);
+		    if (ISNAN(xb[i])) naflag = 1;
+		}
+	    }
+	    expint_collect_signals();
+	}
     }
+    expint_flush_signals();
 
+    if (intflag)
+        warning(R_MSG_NA_INT);
     if (naflag)
         warning(R_MSG_NA);
 
-    if (n == nx)
-        SHALLOW_DUPLICATE_ATTRIB(sy, sx);
-    else if (n == na)
-        SHALLOW_DUPLICATE_ATTRIB(sy, sa);
+    if (n == ny)
+	SHALLOW_DUPLICATE_ATTRIB(sx, sy);
+    else if (n == nn)
+	SHALLOW_DUPLICATE_ATTRIB(sx, sn);
 
     UNPROTECT(3);
 
-    return sy;
+    return sx;
 }
 
-#define EXPINT2_1(A, FUN) expint2_1(CAR(A), CADR(A), CADDR(A), FUN);
+#define EXPINT_INV(A, FUN) expint_inv(CAR(A), CADR(A), CADDR(A), FUN);
 
-SEXP expint_do_expint2(int code, SEXP args)
+SEXP expint_do_expint_inv(int code, SEXP args)
 {
     switch (code)
     {
-    case 1: return EXPINT2_1(args, expint_En);
+    case 1: return EXPINT_INV(args, expint_En_inv);
     default:
-        error(_("internal error in expint_do_expint2"));
+        error(_("internal error in expint_do_expint_inv"));
     }
 
     return args;                /* never used; to keep -Wall happy */
@@ -689,6 +752,12 @@ static expint_tab_struct expint_tab[] = {
     {"E2", expint_do_expint1, 2},
     /* Two argument functions */
     {"En", expint_do_expint2, 1},
+    /* Sequence of orders */
+    {"En_seq", expint_do_expint_seq, 1},
+    /* Derivatives */
+    {"En_deriv", expint_do_expint_deriv, 1},
+    /* Inverse */
+    {"En_inv", expint_do_expint_inv, 1},
     {0, 0, 0}
 };
 
@@ -702,7 +771,7 @@ SEXP expint_do_expint(SEXP args)
     args = CDR(args);
     name = CHAR(STRING_ELT(CAR(args), 0));
 
-    /* Dispatch to expint_do_expint[1,2] */
+    /* Dispatch to expint_do_expint[1,2,_seq,_deriv,_inv] */
     for (i = 0; expint_tab[i].name; i++)
     {
         if (!strcmp(expint_tab[i].name, name))
@@ -6,27 +6,101 @@
  *  AUTHOR: Vincent Goulet <vincent.goulet@act.ulaval.ca>
  */
 
+#include <limits.h>
 #include <Rinternals.h>
+#include <R_ext/Rdynload.h>
+#include "libexpint.h"
 
 /* Error messages */
 #define R_MSG_NA        _("NaNs produced")
+#define R_MSG_NA_INT    _("NAs introduced by coercion to integer range")
 
 /* Functions accessed from .External() */
 SEXP expint_do_expint(SEXP);
 SEXP expint_do_expint1(int, SEXP);
 SEXP expint_do_expint2(int, SEXP);
+SEXP expint_do_expint_seq(int, SEXP);
+SEXP expint_do_expint_deriv(int, SEXP);
+SEXP expint_do_expint_inv(int, SEXP);
 SEXP expint_do_gammainc(SEXP);
+SEXP expint_do_gammainc_ladder(SEXP);
+SEXP expint_do_gammainc_deriv(SEXP);
+SEXP expint_do_gammainc_inv(SEXP);
+SEXP expint_do_stats(SEXP);
+SEXP expint_do_stats_reset(SEXP);
+SEXP expint_do_cache(SEXP);
+SEXP expint_do_cache_stats(SEXP);
+SEXP expint_do_cache_clear(SEXP);
+SEXP expint_do_table(SEXP);
+SEXP expint_do_table_eval(SEXP);
+SEXP expint_do_table_save(SEXP);
+SEXP expint_do_table_load(SEXP);
+SEXP expint_do_table_info(SEXP);
+SEXP expint_do_stream(SEXP);
+int expint_nthreads(SEXP);
+int expint_precision(SEXP);
+int *expint_status_vector(SEXP, R_xlen_t, SEXP *);
+double *expint_error_vector(SEXP, R_xlen_t, SEXP *);
+double *expint_result_vector(SEXP, SEXP, SEXP, SEXP, R_xlen_t, SEXP *);
 
-/* Exported functions */
-double expint_E1(double, int);
-double expint_E2(double, int);
-double expint_En(double, int, int);
-double gamma_inc(double, double);
+/* Arguments read by blocks of EXPINT_BLOCK values */
+SEXP expint_real_or_integer(SEXP);
+void expint_read_real(SEXP, R_xlen_t, R_xlen_t, double *);
+double expint_real_elt(SEXP, R_xlen_t);
 
-/* Constants (taken from gsl_machine.h in GSL sources) */
-#define LOG_DBL_MIN   (-7.0839641853226408e+02)
-#define LOG_DBL_MAX    7.0978271289338397e+02
-#define EULER_CNST     0.57721566490153286060651209008
+/* Order read as a double converted to an int as by coerceVector():
+ * truncated, NA if NaN or out of the range of int. Safe to call from
+ * the worker threads. */
+static inline int expint_order(double a)
+{
+    return (ISNAN(a) || a >= INT_MAX + 1.0 || a <= INT_MIN) ?
+	NA_INTEGER : (int) a;
+}
 
-/* Macros */
-#define E1_IS_ODD(n)  ((n) & 1)	/* taken from GSL */
+/* Lazy results */
+enum {
+    EXPINT_LAZY_E1 = 1,
+    EXPINT_LAZY_E2,
+    EXPINT_LAZY_EN,
+    EXPINT_LAZY_GAMMA_INC
+};
+void expint_lazy_init(DllInfo *);
+
+/* Scaling and log scale of the incomplete gamma function, passed as
+ * a single integer in place of the scaling of the other functions */
+#define EXPINT_GAMMA_INC_FLAGS(scale, give_log) ((scale) | (give_log) << 1)
+#define EXPINT_GAMMA_INC_SCALE(flags)           ((flags) & 1)
+#define EXPINT_GAMMA_INC_LOG(flags)             (((flags) >> 1) & 1)
+
+static inline double expint_gamma_inc(double a, double x, int scale,
+				      int give_log)
+{
+    return give_log ? gamma_inc_log(a, x, scale) :
+	scale ? gamma_inc_scaled(a, x) : gamma_inc(a, x);
+}
+
+static inline double expint_gamma_inc_e(double a, double x, int scale,
+					int give_log, double *err)
+{
+    return give_log ? gamma_inc_log_e(a, x, scale, err) :
+	scale ? gamma_inc_scaled_e(a, x, err) : gamma_inc_e(a, x, err);
+}
+
+SEXP expint_lazy(int, SEXP, SEXP, int, int);
+
+/* Deduplication of the arguments */
+R_xlen_t expint_unique(SEXP, SEXP, R_xlen_t, R_xlen_t **, R_xlen_t **);
+void expint_scatter(SEXP, R_xlen_t, const R_xlen_t *, SEXP, SEXP, double *);
+
+/* Warnings for the conditions met by the workhorses */
+void expint_signals_init(void);
+void expint_defer_signals(void);
+void expint_collect_signals(void);
+void expint_flush_signals(void);
+SEXP expint_protect_signals(SEXP (*)(void *), void *);
+
+/* Number of elements per task in parallel loops */
+#define EXPINT_CHUNK 256
+
+/* Number of elements of the arguments read at once */
+#define EXPINT_BLOCK (64 * EXPINT_CHUNK)
@@ -1,6 +1,6 @@
 /*  == expint: Exponential Integral and Incomplete Gamma Function ==
  *
- *  Functions to compute the incomplete gamma function
+ *  R interface to the function computing the incomplete gamma function
  *
  *     G(a,x) = int_x^infty t^{a-1} exp(-t) dt
  *
@@ -9,11 +9,7 @@
  *
  *  Copyright (C) 2016-2026 Vincent Goulet
  *
- *  The code in part IMPLEMENTATION is derived from the GNU Scientific
- *  Library (GSL) v2.2.1 <https://www.gnu.org/software/gsl/>
- *
- *  Copyright (C) 2007 Brian Gough
- *  Copyright (C) 1996, 1997, 1998, 1999, 2000, 2001, 2002 Gerard Jungman
+ *  The workhorse is in libexpint/gamma_inc.c.
  *
  *  The code in part R TO C INTERFACE is derived from R source code.
  *
@@ -36,163 +32,341 @@
  *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
  *  02110-1301, USA.
  *
- *  AUTHOR for the GSL: G. Jungman
  *  AUTHOR for expint: Vincent Goulet <vincent.goulet@act.ulaval.ca>
  *                     with much indirect help from the R Core Team
  */
 
 #include <R.h>
 #include <Rinternals.h>
-#include <Rmath.h>
 #include "locale.h"
 #include "expint.h"
 
-
 /*
- *  IMPLEMENTATION OF THE WORKHORSE
+ *  R TO C INTERFACE
  *
- *  Adapted from "special functions" material in the GSL.
+ *  Adapted from src/main/arithmetic.c in R sources and from a similar
+ *  scheme in package actuar. Main difference: everything is in this
+ *  one file.
  *
  */
-
-/* Continued fraction which occurs in evaluation
- * of Q(a,x) or Gamma(a,x).
- *
- *              1   (1-a)/x  1/x  (2-a)/x   2/x  (3-a)/x
- *   F(a,x) =  ---- ------- ----- -------- ----- -------- ...
- *             1 +   1 +     1 +   1 +      1 +   1 +
+/* Function to compute G(a, x) for the vectors 'sa' and 'sx', scaled
+ * by e^x x^(1-a) when 'sI' is TRUE and on the log scale when 'sG' is
+ * TRUE. The recycling of the arguments restarts at the beginning of
+ * each chunk of EXPINT_CHUNK values so that chunks may be processed
+ * in parallel. The cost per element
+ * varies widely (a few operations for 'a > 0', up to thousands of
+ * iterations of the continued fraction or of the recursion for 'a <
+ * 0'), hence the dynamic schedule with small chunks.
  *
- * Hans E. Plesser, 2002-01-22 (hans dot plesser at itf dot nlh dot no).
+ * For x = 0, the result is gammafn(a) and the R math library may
+ * issue a warning for some values of 'a'. Since warnings may only be
+ * issued from the main thread, these elements are computed after the
+ * parallel loop over each block of arguments.
  *
- * Split out from gamma_inc_Q_CF() by GJ [Tue Apr  1 13:16:41 MST 2003].
- * See gamma_inc_Q_CF() below.
- *
- */
-double gamma_inc_F_CF(double a, double x)
+ * When deduplication is requested, the function is evaluated at the
+ * distinct pairs of recycled arguments only, and the results
+ * scattered back. A lazy result, computed on access, is returned on
+ * request unless the status, the error or deduplication is also
+ * requested, or the results go to the vector 'sO' supplied by the
+ * caller, from element 'sOff'. The estimates of the absolute error
+ * are attached to the result when 'sE' is TRUE. */
+static SEXP gammainc2(SEXP sa, SEXP sx, SEXP sI, SEXP sG, SEXP sS, SEXP sE,
+		      SEXP sT, SEXP sP, SEXP sU, SEXP sL, SEXP sO, SEXP sOff)
 {
-    const int    nmax  =  5000;
-    const double small =  R_pow_di(DBL_EPSILON, 3);
+    SEXP sy, sst = R_NilValue, serr = R_NilValue;
+    R_xlen_t b, c, n, nx, na, nchunks, m, *map, *first;
+    double *a, *x, *y, *e;
+    int *st, naflag = 0, deferred;
+    int scale = asLogical(sI) == TRUE, give_log = asLogical(sG) == TRUE;
+
+    if (!isNumeric(sa) || !isNumeric(sx))
+        error(_("invalid arguments"));
 
-    double hn = 1.0;           /* convergent */
-    double Cn = 1.0 / small;
-    double Dn = 1.0;
-    int n;
+    na = XLENGTH(sa);
+    nx = XLENGTH(sx);
+    if ((na == 0) || (nx == 0))
+        return isNull(sO) ? allocVector(REALSXP, 0) : sO;
+
+    n = (nx < na) ? na : nx;
 
-    /* n == 1 has a_1, b_1, b_0 independent of a,x,
-       so that has been done by hand                */
-    for (n = 2 ; n < nmax ; n++)
+    if (asLogical(sL) == TRUE && asLogical(sS) != TRUE &&
+	asLogical(sE) != TRUE && asLogical(sU) != TRUE && isNull(sO))
     {
-	double an;
-	double delta;
-
-	if (E1_IS_ODD(n))
-	    an = 0.5 * (n - 1)/x;
-	else
-	    an = (0.5 * n - a)/x;
-
-	Dn = 1.0 + an * Dn;
-	if (fabs(Dn) < small)
-	    Dn = small;
-	Cn = 1.0 + an/Cn;
-	if (fabs(Cn) < small)
-	    Cn = small;
-	Dn = 1.0/Dn;
-	delta = Cn * Dn;
-	hn *= delta;
-	if (fabs(delta-1.0) < DBL_EPSILON)
-	    break;
+	PROTECT(sy = expint_lazy(EXPINT_LAZY_GAMMA_INC, sx, sa,
+				 EXPINT_GAMMA_INC_FLAGS(scale, give_log),
+				 expint_precision(sP)));
+	if (n == na)
+	    SHALLOW_DUPLICATE_ATTRIB(sy, sa);
+	else if (n == nx)
+	    SHALLOW_DUPLICATE_ATTRIB(sy, sx);
+	UNPROTECT(1);
+	return sy;
     }
 
-    if (n == nmax)
-	warning(_("maximum number of iterations reached in gamma_inc_F_CF"));
+    PROTECT(sa = expint_real_or_integer(sa));
+    PROTECT(sx = expint_real_or_integer(sx));
+    y = expint_result_vector(sO, sOff, sS, sE, n, &sy);
 
-    return hn;
-}
+    if (asLogical(sU) == TRUE &&
+	(m = expint_unique(sa, sx, n, &map, &first)) >= 0)
+    {
+	SEXP sua, sux, suy;
+	PROTECT(sua = allocVector(REALSXP, m));
+	PROTECT(sux = allocVector(REALSXP, m));
+	for (c = 0; c < m; c++)
+	{
+	    REAL(sua)[c] = expint_real_elt(sa, first[c] % na);
+	    REAL(sux)[c] = expint_real_elt(sx, first[c] % nx);
+	}
+	PROTECT(suy = gammainc2(sua, sux, sI, sG, sS, sE, sT, sP, R_NilValue,
+				R_NilValue, R_NilValue, R_NilValue));
+	expint_scatter(suy, n, map,
+		       !isNull(sO) ? R_NilValue :
+		       (n == na) ? sa : (n == nx) ? sx : R_NilValue, sy, y);
+	UNPROTECT(6);
+	return sy;
+    }
 
-/* Adapted from specfun/gamma_inc.c in GSL sources. Note that base R
- * function 'gammafn' and 'pgamma' are used for positive values of
- * 'a'. */
-double gamma_inc(double a, double x)
-{
-#ifdef IEEE_754
-    if (ISNAN(x) || ISNAN(a))
-	return a + x;
+    a = (double *) R_alloc(EXPINT_BLOCK, sizeof(double));
+    x = (double *) R_alloc(EXPINT_BLOCK, sizeof(double));
+
+    int nthreads = expint_nthreads(sT);
+    int prec = expint_precision(sP);
+    st = expint_status_vector(sS, n, &sst);
+    e = expint_error_vector(sE, n, &serr);
+
+    expint_defer_signals();
+    for (b = 0; b < n; b += EXPINT_BLOCK)
+    {
+	R_xlen_t nb = (n - b < EXPINT_BLOCK) ? n - b : EXPINT_BLOCK;
+	double *yb = y + b;
+
+	expint_read_real(sa, b, nb, a);
+	expint_read_real(sx, b, nb, x);
+	nchunks = (nb + EXPINT_CHUNK - 1) / EXPINT_CHUNK;
+	deferred = 0;
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nthreads) schedule(dynamic, 1) \
+    reduction(||:naflag, deferred) if (nthreads > 1)
 #endif
+	for (c = 0; c < nchunks; c++)
+	{
+	    R_xlen_t i, end = (c + 1) * EXPINT_CHUNK;
+	    double ai, xi;
+	    int oprec = expint_set_precision(prec);
+
+	    if (end > nb) end = nb;
+	    expint_take_status();
+	    for (i = c * EXPINT_CHUNK; i < end; i++)
+	    {
+		ai = a[i];
+		xi = x[i];
+		if (ISNA(ai) || ISNA(xi))
+		{
+		    yb[i] = NA_REAL;
+		    if (e != NULL) e[b + i] = NA_REAL;
+		}
+		else if (ISNAN(ai) || ISNAN(xi))
+		{
+		    yb[i] = R_NaN;
+		    if (e != NULL) e[b + i] = R_NaN;
+		}
+		else if (xi == 0.0 && nthreads > 1)
+		    deferred = 1;
+		else
+		{
+		    yb[i] = (e == NULL) ?
+			expint_gamma_inc(ai, xi, scale, give_log) :
+			expint_gamma_inc_e(ai, xi, scale, give_log, e + b + i);
+		    if (ISNAN(yb[i])) naflag = 1;
+		    if (st != NULL) st[b + i] = expint_take_status();
+		}
+	    }
+	    expint_set_precision(oprec);
+	    expint_collect_signals();
+	}
+
+	if (deferred)
+	{
+	    R_xlen_t i;
+	    for (i = 0; i < nb; i++)
+	    {
+		if (x[i] == 0.0 && !ISNAN(a[i]))
+		{
+		    yb[i] = (e == NULL) ?
+			expint_gamma_inc(a[i], x[i], scale, give_log) :
+			expint_gamma_inc_e(a[i], x[i], scale, give_log,
+					   e + b + i);
+		    if (ISNAN(yb[i])) naflag = 1;
+		}
+	    }
+	}
+    }
+    expint_flush_signals();
+
+    if (naflag)
+        warning(R_MSG_NA);
 
-    if (x < 0.0)
-	return(R_NaN);
-    else if (x == 0.0)
-	return gammafn(a);
-    else if (a == 0.0)
-	return expint_E1(x, 0);
-    else if (a > 0.0)
-	return gammafn(a) * pgamma(x, a, 1, 0, 0);
-    else if (x > 0.25)
+    if (isNull(sO))
     {
-	/* continued fraction seems to fail for x too small; otherwise
-	   it is ok, independent of the value of |x/a|, because of the
-	   non-oscillation in the expansion, i.e. the CF is
-	   un-conditionally convergent for a < 0 and x > 0
-	*/
-	return exp((a - 1) * log(x) - x) * gamma_inc_F_CF(a, x);
+	if (n == na)
+	    SHALLOW_DUPLICATE_ATTRIB(sy, sa);
+	else if (n == nx)
+	    SHALLOW_DUPLICATE_ATTRIB(sy, sx);
     }
-    else if (fabs(a) < 0.5)
+    if (st != NULL)
     {
-	/* expint: use the recursion for -0.5 < a < 0 (instead of a
-	 * series expansion as in GSL), relying on the accuracy of
-	 * pgamma for small values of 'a', but nevertheless treat
-	 * this case separately to avoid rounding errors in the loop
-	 * below */
-	const double da = a + 1.0;
-	const double gax = gammafn(da) * pgamma(x, da, 1, 0, 0);
-	const double shift = exp(-x + a * log(x));
-
-	return (gax - shift)/a;
+	setAttrib(sy, install("status"), sst);
+	UNPROTECT(1);
     }
-    else
+    if (e != NULL)
     {
-	/* a = fa + da; da >= 0 */
-	const double fa = floor(a);
-	const double da = a - fa;
+	setAttrib(sy, install("error"), serr);
+	UNPROTECT(1);
+    }
 
-	double gax  = (da > 0.0 ? gammafn(da) * pgamma(x, da, 1, 0, 0)
-		                : expint_E1(x, 0));
-	double alpha = da;
+    UNPROTECT(3);
 
-	/* Gamma(alpha-1,x) = 1/(alpha-1) (Gamma(a,x) - x^(alpha-1) e^-x) */
-	do
-	{
-	    const double shift = exp(-x + (alpha - 1.0) * log(x));
-	    gax = (gax - shift)/(alpha - 1.0);
-	    alpha -= 1.0;
-	} while (alpha > a);
+    return sy;
+}
+
+/* Function called by .External() */
+SEXP expint_do_gammainc(SEXP args)
+{
+    args = CDR(args);	       /* drop function name from arguments */
 
-	return gax;
-  }
+    return gammainc2(CAR(args), CADR(args), CADDR(args), CADDDR(args),
+		     CAD4R(args), CAD4R(CDR(CDDDR(CDDDR(args)))),
+		     CAD4R(CDR(args)), CAD4R(CDDR(args)),
+		     CAD4R(CDDDR(args)), CAD4R(CDR(CDDDR(args))),
+		     CAD4R(CDDR(CDDDR(args))), CAD4R(CDDDR(CDDDR(args))));
 }
 
+/* Function called by .External() for the ladder G(a - k, x), k = 0,
+ * ..., K: the result is a matrix with one row per value of the
+ * recycled arguments. As in gammainc2(), the arguments are read by
+ * blocks of EXPINT_BLOCK values and the rows for x = 0 are computed
+ * after the parallel loop over each block. */
+SEXP expint_do_gammainc_ladder(SEXP args)
+{
+    SEXP sx, sa, sy, names = R_NilValue;
+    R_xlen_t b, c, n, nx, na, nchunks;
+    double *a, *x, *y;
+    int K, naflag = 0, deferred;
 
-/*
- *  R TO C INTERFACE
- *
- *  Adapted from src/main/arithmetic.c in R sources and from a similar
- *  scheme in package actuar. Main difference: everything is in this
- *  one file.
- *
- */
-#define mod_iterate1(n1, n2, i1, i2)            \
-        for (i = i1 = i2 = 0; i < n;            \
-             i1 = (++i1 == n1) ? 0 : i1,        \
-             i2 = (++i2 == n2) ? 0 : i2,        \
-             ++i)
+    args = CDR(args);	       /* drop function name from arguments */
 
-/* Function called by .External() */
-SEXP expint_do_gammainc(SEXP args)
+    if (!isNumeric(CAR(args)) || !isNumeric(CADR(args)) ||
+	!isNumeric(CADDR(args)))
+        error(_("invalid arguments"));
+
+    K = asInteger(CADDR(args));
+    if (K == NA_INTEGER || K < 0)
+        error(_("invalid arguments"));
+
+    na = XLENGTH(CAR(args));
+    nx = XLENGTH(CADR(args));
+    n = ((na == 0) || (nx == 0)) ? 0 : (nx < na) ? na : nx;
+
+    PROTECT(sa = expint_real_or_integer(CAR(args)));
+    PROTECT(sx = expint_real_or_integer(CADR(args)));
+    PROTECT(sy = allocMatrix(REALSXP, n, K + 1));
+    a = (double *) R_alloc(EXPINT_BLOCK, sizeof(double));
+    x = (double *) R_alloc(EXPINT_BLOCK, sizeof(double));
+    y = REAL(sy);
+
+    int nthreads = expint_nthreads(CADDDR(args));
+
+    expint_defer_signals();
+    for (b = 0; b < n; b += EXPINT_BLOCK)
+    {
+	R_xlen_t nb = (n - b < EXPINT_BLOCK) ? n - b : EXPINT_BLOCK;
+	double *yb = y + b;
+
+	expint_read_real(sa, b, nb, a);
+	expint_read_real(sx, b, nb, x);
+	nchunks = (nb + EXPINT_CHUNK - 1) / EXPINT_CHUNK;
+	deferred = 0;
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nthreads) schedule(dynamic, 1) \
+    reduction(||:naflag, deferred) if (nthreads > 1)
+#endif
+	for (c = 0; c < nchunks; c++)
+	{
+	    R_xlen_t i, k, end = (c + 1) * EXPINT_CHUNK;
+
+	    if (end > nb) end = nb;
+	    for (i = c * EXPINT_CHUNK; i < end; i++)
+	    {
+		if (ISNA(a[i]) || ISNA(x[i]))
+		{
+		    for (k = 0; k <= K; k++)
+			yb[i + k * n] = NA_REAL;
+		    continue;
+		}
+		if (x[i] == 0.0 && nthreads > 1)
+		{
+		    deferred = 1;
+		    continue;
+		}
+		gamma_inc_ladder(a[i], x[i], K, yb + i, n);
+		if (!ISNAN(a[i]) && !ISNAN(x[i]))
+		    for (k = 0; k <= K; k++)
+			if (ISNAN(yb[i + k * n])) naflag = 1;
+	    }
+	    expint_collect_signals();
+	}
+
+	if (deferred)
+	{
+	    R_xlen_t i, k;
+	    for (i = 0; i < nb; i++)
+	    {
+		if (x[i] == 0.0 && !ISNA(a[i]))
+		{
+		    gamma_inc_ladder(a[i], x[i], K, yb + i, n);
+		    if (!ISNAN(a[i]))
+			for (k = 0; k <= K; k++)
+			    if (ISNAN(yb[i + k * n])) naflag = 1;
+		}
+	    }
+	}
+    }
+    expint_flush_signals();
+
+    if (naflag)
+        warning(R_MSG_NA);
+
+    if (n == na)
+	names = getAttrib(sa, R_NamesSymbol);
+    else if (n == nx)
+	names = getAttrib(sx, R_NamesSymbol);
+    if (!isNull(names))
+    {
+	SEXP dn;
+	PROTECT(dn = allocVector(VECSXP, 2));
+	SET_VECTOR_ELT(dn, 0, names);
+	setAttrib(sy, R_DimNamesSymbol, dn);
+	UNPROTECT(1);
+    }
+
+    UNPROTECT(3);
+
+    return sy;
+}
+
+/* Function called by .External() for G(a, x) and its partial
+ * derivatives with respect to 'x' and 'a': the result is a matrix
+ * with one row per value of the recycled arguments and three
+ * columns. As in gammainc2(), the arguments are read by blocks of
+ * EXPINT_BLOCK values and the rows for x = 0 are computed after the
+ * parallel loop over each block. */
+SEXP expint_do_gammainc_deriv(SEXP args)
 {
-    SEXP sx, sa, sy;
-    R_xlen_t i, ix, ia, n, nx, na;
-    double ai, *a, xi, *x, *y;
-    Rboolean naflag = FALSE;
+    SEXP sx, sa, sy, dn, names = R_NilValue;
+    R_xlen_t b, c, n, nx, na, nchunks;
+    double *a, *x, *y;
+    int naflag = 0, deferred;
 
     args = CDR(args);	       /* drop function name from arguments */
 
@@ -201,42 +375,168 @@ SEXP expint_do_gammainc(SEXP args)
 
     na = XLENGTH(CAR(args));
     nx = XLENGTH(CADR(args));
-    if ((na == 0) || (nx == 0))
-        return(allocVector(REALSXP, 0));
+    n = ((na == 0) || (nx == 0)) ? 0 : (nx < na) ? na : nx;
 
-    n = (nx < na) ? na : nx;
-
-    PROTECT(sa = coerceVector(CAR(args), REALSXP));
-    PROTECT(sx = coerceVector(CADR(args), REALSXP));
-    PROTECT(sy = allocVector(REALSXP, n));
-    a = REAL(sa);
-    x = REAL(sx);
+    PROTECT(sa = expint_real_or_integer(CAR(args)));
+    PROTECT(sx = expint_real_or_integer(CADR(args)));
+    PROTECT(sy = allocMatrix(REALSXP, n, 3));
+    a = (double *) R_alloc(EXPINT_BLOCK, sizeof(double));
+    x = (double *) R_alloc(EXPINT_BLOCK, sizeof(double));
     y = REAL(sy);
 
-    mod_iterate1(na, nx, ia, ix)
+    int nthreads = expint_nthreads(CADDR(args));
+
+    expint_defer_signals();
+    for (b = 0; b < n; b += EXPINT_BLOCK)
     {
-        ai = a[ia];
-        xi = x[ix];
-	if (ISNA(ai) || ISNA(xi))
-	    y[i] = NA_REAL;
-        else if (ISNAN(ai) || ISNAN(xi))
-	    y[i] = R_NaN;
-        else
-        {
-	    y[i] = gamma_inc(ai, xi);
-	    if (ISNAN(y[i])) naflag = TRUE;
-        }
+	R_xlen_t nb = (n - b < EXPINT_BLOCK) ? n - b : EXPINT_BLOCK;
+	double *yb = y + b;
+
+	expint_read_real(sa, b, nb, a);
+	expint_read_real(sx, b, nb, x);
+	nchunks = (nb + EXPINT_CHUNK - 1) / EXPINT_CHUNK;
+	deferred = 0;
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nthreads) schedule(dynamic, 1) \
+    reduction(||:naflag, deferred) if (nthreads > 1)
+#endif
+	for (c = 0; c < nchunks; c++)
+	{
+	    R_xlen_t i, k, end = (c + 1) * EXPINT_CHUNK;
+
+	    if (end > nb) end = nb;
+	    for (i = c * EXPINT_CHUNK; i < end; i++)
+	    {
+		if (ISNA(a[i]) || ISNA(x[i]))
+		{
+		    for (k = 0; k < 3; k++)
+			yb[i + k * n] = NA_REAL;
+		    continue;
+		}
+		if (x[i] == 0.0 && nthreads > 1)
+		{
+		    deferred = 1;
+		    continue;
+		}
+		gamma_inc_deriv(a[i], x[i], yb + i, n);
+		if (!ISNAN(a[i]) && !ISNAN(x[i]))
+		    for (k = 0; k < 3; k++)
+			if (ISNAN(yb[i + k * n])) naflag = 1;
+	    }
+	    expint_collect_signals();
+	}
+
+	if (deferred)
+	{
+	    R_xlen_t i, k;
+	    for (i = 0; i < nb; i++)
+	    {
+		if (x[i] == 0.0 && !ISNA(a[i]))
+		{
+		    gamma_inc_deriv(a[i], x[i], yb + i, n);
+		    if (!ISNAN(a[i]))
+			for (k = 0; k < 3; k++)
+			    if (ISNAN(yb[i + k * n])) naflag = 1;
+		}
+	    }
+	}
     }
+    expint_flush_signals();
 
     if (naflag)
         warning(R_MSG_NA);
 
     if (n == na)
-        SHALLOW_DUPLICATE_ATTRIB(sy, sa);
+	names = getAttrib(sa, R_NamesSymbol);
     else if (n == nx)
-        SHALLOW_DUPLICATE_ATTRIB(sy, sx);
+	names = getAttrib(sx, R_NamesSymbol);
+    PROTECT(dn = allocVector(VECSXP, 2));
+    SET_VECTOR_ELT(dn, 0, names);
+    SET_VECTOR_ELT(dn, 1, allocVector(STRSXP, 3));
+    SET_STRING_ELT(VECTOR_ELT(dn, 1), 0, mkChar("value"));
+    SET_STRING_ELT(VECTOR_ELT(dn, 1), 1, mkChar("dx"));
+    SET_STRING_ELT(VECTOR_ELT(dn, 1), 2, mkChar("da"));
+    setAttrib(sy, R_DimNamesSymbol, dn);
 
-    UNPROTECT(3);
+    UNPROTECT(4);
 
     return sy;
 }
+
+/* Function called by .External() for the inverse: the solutions 'x'
+ * of G(a, x) = y for the recycled arguments 'a' and 'y', read by
+ * blocks of EXPINT_BLOCK values. */
+SEXP expint_do_gammainc_inv(SEXP args)
+{
+    SEXP sa, sy, sx;
+    R_xlen_t b, c, n, na, ny, nchunks;
+    double *a, *y, *x;
+    int naflag = 0;
+
+    args = CDR(args);	       /* drop function name from arguments */
+
+    if (!isNumeric(CAR(args)) || !isNumeric(CADR(args)))
+        error(_("invalid arguments"));
+
+    na = XLENGTH(CAR(args));
+    ny = XLENGTH(CADR(args));
+    if ((na == 0) || (ny == 0))
+        return(allocVector(REALSXP, 0));
+
+    n = (ny < na) ? na : ny;
+    PROTECT(sa = expint_real_or_integer(CAR(args)));
+    PROTECT(sy = expint_real_or_integer(CADR(args)));
+    PROTECT(sx = allocVector(REALSXP, n));
+    a = (double *) R_alloc(EXPINT_BLOCK, sizeof(double));
+    y = (double *) R_alloc(EXPINT_BLOCK, sizeof(double));
+    x = REAL(sx);
+
+    int nthreads = expint_nthreads(CADDR(args));
+
+    expint_defer_signals();
+    for (b = 0; b < n; b += EXPINT_BLOCK)
+    {
+	R_xlen_t nb = (n - b < EXPINT_BLOCK) ? n - b : EXPINT_BLOCK;
+	double *xb = x + b;
+
+	expint_read_real(sa, b, nb, a);
+	expint_read_real(sy, b, nb, y);
+	nchunks = (nb + EXPINT_CHUNK - 1) / EXPINT_CHUNK;
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nthreads) schedule(dynamic, 1) \
+    reduction(||:naflag) if (nthreads > 1)
+#endif
+	for (c = 0; c < nchunks; c++)
+	{
+	    R_xlen_t i, end = (c + 1) * EXPINT_CHUNK;
+
+	    if (end > nb) end = nb;
+	    for (i = c * EXPINT_CHUNK; i < end; i++)
+	    {
+		if (ISNA(a[i]) || ISNA(y[i]))
+		    xb[i] = NA_REAL;
+		else if (ISNAN(a[i]) || ISNAN(y[i]))
+		    xb[i] = R_NaN;
+		else
+		{
+		    xb[i] = gamma_inc_inv(a[i], y[i]);
+		    if (ISNAN(xb[i])) naflag = 1;
+		}
+	    }
+	    expint_collect_signals();
+	}
+    }
+    expint_flush_signals();
+
+    if (naflag)
+        warning(R_MSG_NA);
+
+    if (n == na)
+	SHALLOW_DUPLICATE_ATTRIB(sx, sa);
+    else if (n == ny)
+	SHALLOW_DUPLICATE_ATTRIB(sx, sy);
+
+    UNPROTECT(3);
+
+    return sx;
+}
@@ -10,20 +10,144 @@
 #include <R_ext/Rdynload.h>
 #include "expint.h"
 
+/* Entry points that defer the warnings, run so that an error does
+ * not leave them deferred; see status.c */
+#define PROTECTED_ENTRY(fun)						\
+    static SEXP fun##_body(void *args) { return fun((SEXP) args); }	\
+    static SEXP fun##_entry(SEXP args)					\
+    {									\
+	return expint_protect_signals(fun##_body, args);		\
+    }
+
+PROTECTED_ENTRY(expint_do_expint)
+PROTECTED_ENTRY(expint_do_gammainc)
+PROTECTED_ENTRY(expint_do_gammainc_ladder)
+PROTECTED_ENTRY(expint_do_gammainc_deriv)
+PROTECTED_ENTRY(expint_do_gammainc_inv)
+PROTECTED_ENTRY(expint_do_table)
+PROTECTED_ENTRY(expint_do_table_eval)
+PROTECTED_ENTRY(expint_do_stream)
+
 static const R_ExternalMethodDef ExternalEntries[] = {
-    {"expint_do_expint", (DL_FUNC) &expint_do_expint, -1},
-    {"expint_do_gammainc", (DL_FUNC) &expint_do_gammainc, -1},
+    {"expint_do_expint", (DL_FUNC) &expint_do_expint_entry, -1},
+    {"expint_do_gammainc", (DL_FUNC) &expint_do_gammainc_entry, -1},
+    {"expint_do_gammainc_ladder", (DL_FUNC) &expint_do_gammainc_ladder_entry, -1},
+    {"expint_do_gammainc_deriv", (DL_FUNC) &expint_do_gammainc_deriv_entry, -1},
+    {"expint_do_gammainc_inv", (DL_FUNC) &expint_do_gammainc_inv_entry, -1},
+    {"expint_do_stats", (DL_FUNC) &expint_do_stats, -1},
+    {"expint_do_stats_reset", (DL_FUNC) &expint_do_stats_reset, -1},
+    {"expint_do_cache", (DL_FUNC) &expint_do_cache, -1},
+    {"expint_do_cache_stats", (DL_FUNC) &expint_do_cache_stats, -1},
+    {"expint_do_cache_clear", (DL_FUNC) &expint_do_cache_clear, -1},
+    {"expint_do_table", (DL_FUNC) &expint_do_table_entry, -1},
+    {"expint_do_table_eval", (DL_FUNC) &expint_do_table_eval_entry, -1},
+    {"expint_do_table_save", (DL_FUNC) &expint_do_table_save, -1},
+    {"expint_do_table_load", (DL_FUNC) &expint_do_table_load, -1},
+    {"expint_do_table_info", (DL_FUNC) &expint_do_table_info, -1},
+    {"expint_do_stream", (DL_FUNC) &expint_do_stream_entry, -1},
     {NULL, NULL, 0}
 };
 
+/* Vectorized functions of the C API: the warnings are deferred until
+ * the end of the computations, as in the R interface */
+static void api_expint_E1_vec(const double *x, R_xlen_t n, R_xlen_t incx,
+			      int scale, double *y)
+{
+    expint_defer_signals();
+    expint_E1_vec(x, n, incx, scale, y);
+    expint_flush_signals();
+}
+
+static void api_expint_E2_vec(const double *x, R_xlen_t n, R_xlen_t incx,
+			      int scale, double *y)
+{
+    expint_defer_signals();
+    expint_E2_vec(x, n, incx, scale, y);
+    expint_flush_signals();
+}
+
+static void api_expint_En_vec(const double *x, R_xlen_t n, R_xlen_t incx,
+			      const int *order, R_xlen_t norder, int scale,
+			      double *y)
+{
+    expint_defer_signals();
+    expint_En_vec(x, n, incx, order, norder, scale, y);
+    expint_flush_signals();
+}
+
+static void api_gamma_inc_vec(const double *a, R_xlen_t n, R_xlen_t inca,
+			      const double *x, R_xlen_t nx, double *y)
+{
+    expint_defer_signals();
+    gamma_inc_vec(a, n, inca, x, nx, y);
+    expint_flush_signals();
+}
+
+static void api_expint_En_seq(double x, int nmax, int scale,
+			      double *y, R_xlen_t incy)
+{
+    expint_defer_signals();
+    expint_En_seq(x, nmax, scale, y, incy);
+    expint_flush_signals();
+}
+
+static void api_gamma_inc_ladder(double a, double x, int K,
+				 double *y, R_xlen_t incy)
+{
+    expint_defer_signals();
+    gamma_inc_ladder(a, x, K, y, incy);
+    expint_flush_signals();
+}
+
+static void api_expint_En_deriv(double x, int n, int nderiv, int scale,
+				double *y, R_xlen_t incy)
+{
+    expint_defer_signals();
+    expint_En_deriv(x, n, nderiv, scale, y, incy);
+    expint_flush_signals();
+}
+
+static void api_gamma_inc_deriv(double a, double x, double *y, R_xlen_t incy)
+{
+    expint_defer_signals();
+    gamma_inc_deriv(a, x, y, incy);
+    expint_flush_signals();
+}
+
 void attribute_visible R_init_expint(DllInfo *dll)
 {
     R_registerRoutines(dll, NULL, NULL, NULL, ExternalEntries);
     R_useDynamicSymbols(dll, FALSE);
     R_forceSymbols(dll, TRUE);
 
+    expint_batch_init();
+    expint_signals_init();
+    expint_lazy_init(dll);
+
     R_RegisterCCallable("expint", "expint_E1", (DL_FUNC) expint_E1);
     R_RegisterCCallable("expint", "expint_E2", (DL_FUNC) expint_E2);
     R_RegisterCCallable("expint", "expint_En", (DL_FUNC) expint_En);
     R_RegisterCCallable("expint", "gamma_inc", (DL_FUNC) gamma_inc);
+    R_RegisterCCallable("expint", "gamma_inc_scaled", (DL_FUNC) gamma_inc_scaled);
+    R_RegisterCCallable("expint", "gamma_inc_log", (DL_FUNC) gamma_inc_log);
+    R_RegisterCCallable("expint", "expint_E1_e", (DL_FUNC) expint_E1_e);
+    R_RegisterCCallable("expint", "expint_E2_e", (DL_FUNC) expint_E2_e);
+    R_RegisterCCallable("expint", "expint_En_e", (DL_FUNC) expint_En_e);
+    R_RegisterCCallable("expint", "gamma_inc_e", (DL_FUNC) gamma_inc_e);
+    R_RegisterCCallable("expint", "gamma_inc_scaled_e", (DL_FUNC) gamma_inc_scaled_e);
+    R_RegisterCCallable("expint", "gamma_inc_log_e", (DL_FUNC) gamma_inc_log_e);
+    R_RegisterCCallable("expint", "expint_En_inv", (DL_FUNC) expint_En_inv);
+    R_RegisterCCallable("expint", "gamma_inc_inv", (DL_FUNC) gamma_inc_inv);
+    R_RegisterCCallable("expint", "expint_E1_vec", (DL_FUNC) api_expint_E1_vec);
+    R_RegisterCCallable("expint", "expint_E2_vec", (DL_FUNC) api_expint_E2_vec);
+    R_RegisterCCallable("expint", "expint_En_vec", (DL_FUNC) api_expint_En_vec);
+    R_RegisterCCallable("expint", "gamma_inc_vec", (DL_FUNC) api_gamma_inc_vec);
+    R_RegisterCCallable("expint", "expint_En_seq", (DL_FUNC) api_expint_En_seq);
+    R_RegisterCCallable("expint", "gamma_inc_ladder", (DL_FUNC) api_gamma_inc_ladder);
+    R_RegisterCCallable("expint", "expint_En_deriv", (DL_FUNC) api_expint_En_deriv);
+    R_RegisterCCallable("expint", "gamma_inc_deriv", (DL_FUNC) api_gamma_inc_deriv);
+    R_RegisterCCallable("expint", "expint_set_precision", (DL_FUNC) expint_set_precision);
+    R_RegisterCCallable("expint", "expint_cache_enable", (DL_FUNC) expint_cache_enable);
+    R_RegisterCCallable("expint", "expint_cache_clear", (DL_FUNC) expint_cache_clear);
+    R_RegisterCCallable("expint", "expint_cache_info", (DL_FUNC) expint_cache_info);
 }
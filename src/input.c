@@ -0,0 +1,78 @@
+/*  == expint: Exponential Integral and Incomplete Gamma Function ==
+ *
+ *  Reading of the arguments of the R functions by regions, without
+ *  coercion of the whole vectors: integer vectors and compact
+ *  sequences (ALTREP) are read block by block into a buffer of
+ *  doubles, so that the memory used by the computations does not
+ *  exceed much the size of the result.
+ *
+ *  Copyright (C) 2026 Vincent Goulet
+ *
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU General Public License as
+ *  published by the Free Software Foundation; either version 3 of the
+ *  License, or (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ *  General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ *  02110-1301, USA.
+ *
+ *  AUTHOR: Vincent Goulet <vincent.goulet@act.ulaval.ca>
+ */
+
+#include <R.h>
+#include <Rinternals.h>
+#include "expint.h"
+
+/* Argument as a real or integer vector; other types are coerced to
+ * reals. The result is not protected. */
+SEXP expint_real_or_integer(SEXP s)
+{
+    if (TYPEOF(s) == REALSXP || TYPEOF(s) == INTSXP)
+	return s;
+
+    return coerceVector(s, REALSXP);
+}
+
+/* Values 'start', ..., 'start + len - 1' of the real or integer vector
+ * 's', recycled, as doubles. Integer NAs become real NAs. Must be
+ * called from the main thread since ALTREP methods may allocate. */
+void expint_read_real(SEXP s, R_xlen_t start, R_xlen_t len, double *buf)
+{
+    R_xlen_t i, k, ns = XLENGTH(s);
+    int ibuf[EXPINT_CHUNK];
+
+    for (i = 0; i < len; i += k)
+    {
+	R_xlen_t j = (start + i) % ns;
+	k = (ns - j < len - i) ? ns - j : len - i;
+	if (TYPEOF(s) == REALSXP)
+	    k = REAL_GET_REGION(s, j, k, buf + i);
+	else
+	{
+	    R_xlen_t l;
+	    if (k > EXPINT_CHUNK) k = EXPINT_CHUNK;
+	    k = INTEGER_GET_REGION(s, j, k, ibuf);
+	    for (l = 0; l < k; l++)
+		buf[i + l] = (ibuf[l] == NA_INTEGER) ? NA_REAL : ibuf[l];
+	}
+    }
+}
+
+/* Element 'i' of the real or integer vector 's' as a double */
+double expint_real_elt(SEXP s, R_xlen_t i)
+{
+    if (TYPEOF(s) == REALSXP)
+	return REAL_ELT(s, i);
+    else
+    {
+	int v = INTEGER_ELT(s, i);
+	return (v == NA_INTEGER) ? NA_REAL : v;
+    }
+}
@@ -0,0 +1,382 @@
+/*  == expint: Exponential Integral and Incomplete Gamma Function ==
+ *
+ *  Lazy results: ALTREP real vectors holding the arguments of a call
+ *  and computing the values on demand, by chunks of EXPINT_CHUNK
+ *  elements, when elements or regions are accessed.
+ *
+ *  The first data field of the object holds the specification of
+ *  the call: the arguments 'x' and 'a' (order or parameter of the
+ *  incomplete gamma function) as given, and an integer vector with
+ *  the function, the scaling flag and the precision. The arguments
+ *  are read by regions, hence compact sequences remain compact. The
+ *  second data field holds a list of the chunks computed so far
+ *  (NULL elements for the others) until the whole vector is
+ *  requested through its data pointer; it then holds the
+ *  materialized vector.
+ *
+ *  Copyright (C) 2026 Vincent Goulet
+ *
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU General Public License as
+ *  published by the Free Software Foundation; either version 3 of the
+ *  License, or (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ *  General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ *  02110-1301, USA.
+ *
+ *  AUTHOR: Vincent Goulet <vincent.goulet@act.ulaval.ca>
+ */
+
+#include <string.h>
+#include <R.h>
+#include <Rinternals.h>
+#include <R_ext/Altrep.h>
+#include "locale.h"
+#include "expint.h"
+
+static R_altrep_class_t lazy_class;
+
+/* Accessors to the specification of the call */
+#define SPEC_X(spec)     VECTOR_ELT(spec, 0)
+#define SPEC_A(spec)     VECTOR_ELT(spec, 1)
+#define SPEC_FUN(spec)   INTEGER(VECTOR_ELT(spec, 2))[0]
+#define SPEC_SCALE(spec) INTEGER(VECTOR_ELT(spec, 2))[1]
+#define SPEC_PREC(spec)  INTEGER(VECTOR_ELT(spec, 2))[2]
+
+static R_xlen_t spec_length(SEXP spec)
+{
+    R_xlen_t nx = XLENGTH(SPEC_X(spec));
+
+    if (isNull(SPEC_A(spec)))
+	return nx;
+    else
+    {
+	R_xlen_t na = XLENGTH(SPEC_A(spec));
+	return (nx < na) ? na : nx;
+    }
+}
+
+/* Chunk 'c' of the result; NaN values computed from non NaN
+ * arguments are flagged in 'naflag' */
+static SEXP lazy_compute(SEXP spec, R_xlen_t c, int *naflag)
+{
+    SEXP sy;
+    R_xlen_t i, n = spec_length(spec), start = c * EXPINT_CHUNK;
+    R_xlen_t len = (n - start < EXPINT_CHUNK) ? n - start : EXPINT_CHUNK;
+    double x[EXPINT_CHUNK], a[EXPINT_CHUNK], *y;
+    int fun = SPEC_FUN(spec), scale = SPEC_SCALE(spec), oprec;
+
+    PROTECT(sy = allocVector(REALSXP, len));
+    y = REAL(sy);
+    expint_read_real(SPEC_X(spec), start, len, x);
+    if (!isNull(SPEC_A(spec)))
+	expint_read_real(SPEC_A(spec), start, len, a);
+
+    /* set once the calls that may fail are over */
+    oprec = expint_set_precision(SPEC_PREC(spec));
+
+    switch (fun)
+    {
+    case EXPINT_LAZY_E1:
+	expint_E1_batch(x, y, len, scale);
+	break;
+    case EXPINT_LAZY_E2:
+	expint_E2_batch(x, y, len, scale);
+	break;
+    case EXPINT_LAZY_EN:
+	for (i = 0; i < len; i++)
+	{
+	    int ai = expint_order(a[i]);
+	    if (ISNA(x[i]) || ai == NA_INTEGER)
+		y[i] = NA_REAL;
+	    else if (ISNAN(x[i]))
+		y[i] = R_NaN;
+	    else
+	    {
+		y[i] = expint_En(x[i], ai, scale);
+		if (ISNAN(y[i])) *naflag = 1;
+	    }
+	}
+	break;
+    case EXPINT_LAZY_GAMMA_INC:
+	for (i = 0; i < len; i++)
+	{
+	    if (ISNA(a[i]) || ISNA(x[i]))
+		y[i] = NA_REAL;
+	    else if (ISNAN(a[i]) || ISNAN(x[i]))
+		y[i] = R_NaN;
+	    else
+	    {
+		y[i] = expint_gamma_inc(a[i], x[i],
+					EXPINT_GAMMA_INC_SCALE(scale),
+					EXPINT_GAMMA_INC_LOG(scale));
+		if (ISNAN(y[i])) *naflag = 1;
+	    }
+	}
+	break;
+    }
+    if (fun == EXPINT_LAZY_E1 || fun == EXPINT_LAZY_E2)
+	for (i = 0; i < len; i++)
+	    if (ISNAN(y[i]) && !ISNAN(x[i])) *naflag = 1;
+
+    expint_set_precision(oprec);
+    UNPROTECT(1);
+
+    return sy;
+}
+
+/* Chunk 'c' of the result, computed and kept if needed */
+static double *lazy_chunk(SEXP s, R_xlen_t c, int *naflag)
+{
+    SEXP chunks = R_altrep_data2(s), sy = VECTOR_ELT(chunks, c);
+
+    if (isNull(sy))
+    {
+	sy = lazy_compute(R_altrep_data1(s), c, naflag);
+	SET_VECTOR_ELT(chunks, c, sy);
+    }
+
+    return REAL(sy);
+}
+
+static void lazy_warn(int naflag)
+{
+    expint_flush_signals();
+    if (naflag)
+	warning(R_MSG_NA);
+}
+
+/* Computations of the methods below, with the warnings deferred
+ * until the end; they run through expint_protect_signals() since
+ * reading the arguments and allocating the chunks may fail. The
+ * values of elements 'i', ..., 'i + n - 1' go to 'buf', or all the
+ * values to the vector 'sy' when 'buf' is NULL. */
+struct lazy_region {
+    SEXP s, sy;
+    R_xlen_t i, n;
+    double *buf;
+    int naflag;
+};
+
+static SEXP lazy_fill(void *data)
+{
+    struct lazy_region *r = data;
+    SEXP data2 = R_altrep_data2(r->s);
+    R_xlen_t c, j, k;
+
+    expint_defer_signals();
+    if (r->buf == NULL)
+    {
+	/* the chunks are not kept, but copied in the whole vector */
+	for (c = 0; c < XLENGTH(data2); c++)
+	{
+	    SEXP chunk = VECTOR_ELT(data2, c);
+	    if (isNull(chunk))
+		chunk = lazy_compute(R_altrep_data1(r->s), c, &r->naflag);
+	    memcpy(REAL(r->sy) + c * EXPINT_CHUNK, REAL(chunk),
+		   XLENGTH(chunk) * sizeof(double));
+	}
+    }
+    else
+    {
+	for (j = 0; j < r->n; j += k)
+	{
+	    R_xlen_t offset = (r->i + j) % EXPINT_CHUNK;
+	    double *y = lazy_chunk(r->s, (r->i + j) / EXPINT_CHUNK,
+				   &r->naflag);
+	    k = EXPINT_CHUNK - offset;
+	    if (k > r->n - j) k = r->n - j;
+	    memcpy(r->buf + j, y + offset, k * sizeof(double));
+	}
+    }
+    lazy_warn(r->naflag);
+
+    return R_NilValue;
+}
+
+/*
+ * ALTREP methods
+ */
+static R_xlen_t lazy_Length(SEXP s)
+{
+    return spec_length(R_altrep_data1(s));
+}
+
+static Rboolean lazy_Inspect(SEXP s, int pre, int deep, int pvec,
+			     void (*inspect_subtree)(SEXP, int, int, int))
+{
+    SEXP data2 = R_altrep_data2(s);
+
+    if (TYPEOF(data2) == REALSXP)
+	Rprintf(" expint lazy result (materialized)\n");
+    else
+    {
+	R_xlen_t c, done = 0;
+	for (c = 0; c < XLENGTH(data2); c++)
+	    if (!isNull(VECTOR_ELT(data2, c))) done++;
+	Rprintf(" expint lazy result (%.0f of %.0f chunks computed)\n",
+		(double) done, (double) XLENGTH(data2));
+    }
+
+    return TRUE;
+}
+
+/* All the values, computed with the chunks kept so far */
+static void *lazy_Dataptr(SEXP s, Rboolean writeable)
+{
+    SEXP data2 = R_altrep_data2(s), sy;
+    struct lazy_region r;
+
+    if (TYPEOF(data2) == REALSXP)
+	return REAL(data2);
+
+    PROTECT(sy = allocVector(REALSXP, lazy_Length(s)));
+    r = (struct lazy_region) {s, sy, 0, 0, NULL, 0};
+    expint_protect_signals(lazy_fill, &r);
+    R_set_altrep_data2(s, sy);
+    UNPROTECT(1);
+
+    return REAL(sy);
+}
+
+static const void *lazy_Dataptr_or_null(SEXP s)
+{
+    SEXP data2 = R_altrep_data2(s);
+
+    return (TYPEOF(data2) == REALSXP) ? REAL(data2) : NULL;
+}
+
+static double lazy_Elt(SEXP s, R_xlen_t i)
+{
+    SEXP data2 = R_altrep_data2(s);
+    struct lazy_region r;
+    double y;
+
+    if (TYPEOF(data2) == REALSXP)
+	return REAL(data2)[i];
+
+    r = (struct lazy_region) {s, R_NilValue, i, 1, &y, 0};
+    expint_protect_signals(lazy_fill, &r);
+
+    return y;
+}
+
+static R_xlen_t lazy_Get_region(SEXP s, R_xlen_t i, R_xlen_t n, double *buf)
+{
+    SEXP data2 = R_altrep_data2(s);
+    R_xlen_t len = lazy_Length(s);
+    struct lazy_region r;
+
+    if (n > len - i)
+	n = len - i;
+    if (TYPEOF(data2) == REALSXP)
+    {
+	memcpy(buf, REAL(data2) + i, n * sizeof(double));
+	return n;
+    }
+
+    r = (struct lazy_region) {s, R_NilValue, i, n, buf, 0};
+    expint_protect_signals(lazy_fill, &r);
+
+    return n;
+}
+
+/* A copy shares the specification and the chunks computed so far,
+ * that are never modified; a materialized vector is copied as usual */
+static SEXP lazy_Duplicate(SEXP s, Rboolean deep)
+{
+    SEXP data2 = R_altrep_data2(s), sy;
+
+    if (TYPEOF(data2) == REALSXP)
+	return NULL;
+
+    PROTECT(data2 = shallow_duplicate(data2));
+    sy = R_new_altrep(lazy_class, R_altrep_data1(s), data2);
+    UNPROTECT(1);
+
+    return sy;
+}
+
+/* The specification is serialized rather than the values, unless
+ * the vector was materialized, and maybe modified */
+static SEXP lazy_Serialized_state(SEXP s)
+{
+    if (TYPEOF(R_altrep_data2(s)) == REALSXP)
+	return NULL;
+
+    return R_altrep_data1(s);
+}
+
+static SEXP lazy_new(SEXP spec)
+{
+    SEXP chunks, sy;
+    R_xlen_t n = spec_length(spec);
+
+    PROTECT(chunks = allocVector(VECSXP, (n + EXPINT_CHUNK - 1) / EXPINT_CHUNK));
+    sy = R_new_altrep(lazy_class, spec, chunks);
+    UNPROTECT(1);
+
+    return sy;
+}
+
+static SEXP lazy_Unserialize(SEXP class, SEXP state)
+{
+    return lazy_new(state);
+}
+
+/* Register the ALTREP class; called when the package is loaded */
+void expint_lazy_init(DllInfo *dll)
+{
+    lazy_class = R_make_altreal_class("expint_lazy", "expint", dll);
+
+    R_set_altrep_Length_method(lazy_class, lazy_Length);
+    R_set_altrep_Inspect_method(lazy_class, lazy_Inspect);
+    R_set_altrep_Duplicate_method(lazy_class, lazy_Duplicate);
+    R_set_altrep_Serialized_state_method(lazy_class, lazy_Serialized_state);
+    R_set_altrep_Unserialize_method(lazy_class, lazy_Unserialize);
+    R_set_altvec_Dataptr_method(lazy_class, lazy_Dataptr);
+    R_set_altvec_Dataptr_or_null_method(lazy_class, lazy_Dataptr_or_null);
+    R_set_altreal_Elt_method(lazy_class, lazy_Elt);
+    R_set_altreal_Get_region_method(lazy_class, lazy_Get_region);
+}
+
+/* Lazy result of function 'fun' (one of EXPINT_LAZY_*) at 'sx' and,
+ * for E_n(x) and G(a, x), 'sa'. For G(a, x), 'scale' holds the flags
+ * built by EXPINT_GAMMA_INC_FLAGS(). Arguments other than real or
+ * integer vectors are coerced to reals; orders are converted to
+ * integers on access. The arguments are kept as is and marked as not
+ * mutable. */
+SEXP expint_lazy(int fun, SEXP sx, SEXP sa, int scale, int prec)
+{
+    SEXP spec, flags, sy;
+
+    if (TYPEOF(sx) != REALSXP && TYPEOF(sx) != INTSXP)
+	sx = coerceVector(sx, REALSXP);
+    PROTECT(sx);
+    if (!isNull(sa) && TYPEOF(sa) != REALSXP && TYPEOF(sa) != INTSXP)
+	sa = coerceVector(sa, REALSXP);
+    PROTECT(sa);
+    MARK_NOT_MUTABLE(sx);
+    if (!isNull(sa))
+	MARK_NOT_MUTABLE(sa);
+
+    PROTECT(spec = allocVector(VECSXP, 3));
+    PROTECT(flags = allocVector(INTSXP, 3));
+    INTEGER(flags)[0] = fun;
+    INTEGER(flags)[1] = scale;
+    INTEGER(flags)[2] = prec;
+    SET_VECTOR_ELT(spec, 0, sx);
+    SET_VECTOR_ELT(spec, 1, sa);
+    SET_VECTOR_ELT(spec, 2, flags);
+    sy = lazy_new(spec);
+    UNPROTECT(4);
+
+    return sy;
+}
@@ -0,0 +1,192 @@
+/*  == expint: Exponential Integral and Incomplete Gamma Function ==
+ *
+ *  Memoization of gamma_inc() and expint_En().
+ *
+ *  The cache is a hash table of bounded size shared by all threads
+ *  and keyed on the bit patterns of the arguments, along with the
+ *  function, the order, the scaling and the precision. The table is
+ *  split in sets of EXPINT_CACHE_WAYS entries; a value is stored in
+ *  the set given by the hash of its key, replacing the least recently
+ *  used entry of the set. Each set is protected by a spin lock; a
+ *  thread finding a set locked simply computes the value.
+ *
+ *  The cache is disabled by default and the workhorses then only pay
+ *  for a test of 'expint_cache_on'. Values computed while meeting a
+ *  condition (overflow, underflow, etc.) are not stored, so that the
+ *  condition is signaled anew on each call.
+ *
+ *  This file is part of libexpint, the core of package expint that
+ *  does not depend on R; see the Makefile in this directory.
+ *
+ *  Copyright (C) 2026 Vincent Goulet
+ *
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU General Public License as
+ *  published by the Free Software Foundation; either version 3 of the
+ *  License, or (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ *  General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ *  02110-1301, USA.
+ *
+ *  AUTHOR: Vincent Goulet <vincent.goulet@act.ulaval.ca>
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core.h"
+
+#define EXPINT_CACHE_WAYS 4
+
+#ifdef __GNUC__
+#define ADD(p, n) __atomic_fetch_add((p), (n), __ATOMIC_RELAXED)
+#define TRYLOCK(l) (!__atomic_test_and_set((l), __ATOMIC_ACQUIRE))
+#define UNLOCK(l) __atomic_clear((l), __ATOMIC_RELEASE)
+#else
+#define ADD(p, n) (*(p) += (n))
+#define TRYLOCK(l) 1
+#define UNLOCK(l)
+#endif
+
+/* A set of entries; a tag of 0 marks an empty entry */
+struct cache_set {
+    uint64_t tag[EXPINT_CACHE_WAYS];
+    uint64_t ka[EXPINT_CACHE_WAYS];
+    uint64_t kx[EXPINT_CACHE_WAYS];
+    double value[EXPINT_CACHE_WAYS];
+    uint32_t used[EXPINT_CACHE_WAYS]; /* time of last use */
+    uint32_t clock;
+    char lock;
+};
+
+int expint_cache_on = 0;
+static struct cache_set *sets = NULL;
+static size_t nsets = 0;
+static unsigned long long hits = 0, misses = 0;
+
+static uint64_t bits(double x)
+{
+    uint64_t u;
+    memcpy(&u, &x, sizeof(u));
+    return u;
+}
+
+/* Mix of the key (final step of splitmix64) */
+static uint64_t hash(uint64_t tag, uint64_t ka, uint64_t kx)
+{
+    uint64_t h = tag ^ (ka * 0x9E3779B97F4A7C15ULL) ^
+	(kx * 0xC2B2AE3D27D4EB4FULL);
+
+    h ^= h >> 30;
+    h *= 0xBF58476D1CE4E5B9ULL;
+    h ^= h >> 27;
+    h *= 0x94D049BB133111EBULL;
+    return h ^ (h >> 31);
+}
+
+/* Look up the value of function 'tag' at (a, x); return 1 and store
+ * the value in 'res' when found. */
+int expint_cache_lookup(uint64_t tag, double a, double x, double *res)
+{
+    uint64_t ka = bits(a), kx = bits(x);
+    struct cache_set *s = sets + (hash(tag, ka, kx) & (nsets - 1));
+    int j, found = 0;
+
+    if (!TRYLOCK(&s->lock))
+	return 0;
+    for (j = 0; j < EXPINT_CACHE_WAYS; j++)
+    {
+	if (s->tag[j] == tag && s->ka[j] == ka && s->kx[j] == kx)
+	{
+	    *res = s->value[j];
+	    s->used[j] = ++s->clock;
+	    found = 1;
+	    break;
+	}
+    }
+    UNLOCK(&s->lock);
+
+    if (found)
+	ADD(&hits, 1);
+    else
+	ADD(&misses, 1);
+    return found;
+}
+
+/* Store the value of function 'tag' at (a, x) in place of the least
+ * recently used entry of its set. */
+void expint_cache_store(uint64_t tag, double a, double x, double res)
+{
+    uint64_t ka = bits(a), kx = bits(x);
+    struct cache_set *s = sets + (hash(tag, ka, kx) & (nsets - 1));
+    int j, k = 0;
+
+    if (!TRYLOCK(&s->lock))
+	return;
+    for (j = 0; j < EXPINT_CACHE_WAYS; j++)
+    {
+	if (s->tag[j] == 0)
+	{
+	    k = j;
+	    break;
+	}
+	if ((uint32_t) (s->clock - s->used[j]) >
+	    (uint32_t) (s->clock - s->used[k]))
+	    k = j;
+    }
+    s->tag[k] = tag;
+    s->ka[k] = ka;
+    s->kx[k] = kx;
+    s->value[k] = res;
+    s->used[k] = ++s->clock;
+    UNLOCK(&s->lock);
+}
+
+/* Enable the cache with room for at least 'size' values, or disable
+ * it when 'size' is 0. The content of the cache is discarded. Must
+ * not be called while other threads compute. */
+int expint_cache_enable(size_t size)
+{
+    size_t n = 1;
+
+    expint_cache_on = 0;
+    free(sets);
+    sets = NULL;
+    nsets = 0;
+    hits = misses = 0;
+
+    if (size == 0)
+	return 0;
+
+    while (n * EXPINT_CACHE_WAYS < size)
+	n <<= 1;
+    if ((sets = calloc(n, sizeof(struct cache_set))) == NULL)
+	return -1;
+    nsets = n;
+    expint_cache_on = 1;
+    return 0;
+}
+
+/* Discard the content of the cache and the counts of hits and
+ * misses. Must not be called while other threads compute. */
+void expint_cache_clear(void)
+{
+    if (sets != NULL)
+	memset(sets, 0, nsets * sizeof(struct cache_set));
+    hits = misses = 0;
+}
+
+void expint_cache_info(size_t *size, unsigned long long *nhits,
+		       unsigned long long *nmisses)
+{
+    *size = nsets * EXPINT_CACHE_WAYS;
+    *nhits = hits;
+    *nmisses = misses;
+}
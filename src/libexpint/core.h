@@ -0,0 +1,151 @@
+/*  == expint: Exponential Integral and Incomplete Gamma Function ==
+ *
+ *  Private declarations of libexpint and various constant and macro
+ *  definitions.
+ *
+ *  AUTHOR: Vincent Goulet <vincent.goulet@act.ulaval.ca>
+ */
+
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
+#include "libexpint.h"
+
+/* Thread local storage */
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+#define EXPINT_TLS _Thread_local
+#else
+#define EXPINT_TLS __thread
+#endif
+
+/* Record a condition met by a workhorse; the number of conditions
+ * met by the thread tells whether a value may be memoized */
+void expint_signal(int);
+extern EXPINT_TLS unsigned int expint_nsignals;
+
+/* Precision of the calling thread and matching relative tolerance of
+ * the iterative methods; see status.c */
+extern EXPINT_TLS int expint_prec;
+#define EXPINT_EPS(prec) \
+    ((prec) == EXPINT_PREC_SINGLE ? (double) FLT_EPSILON : DBL_EPSILON)
+
+/* Instrumentation; see stats.c */
+#ifdef EXPINT_NO_STATS
+#define EXPINT_STATS_ON 0
+#else
+extern int expint_stats_on;
+#define EXPINT_STATS_ON expint_stats_on
+#endif
+void expint_stats_count_E1(int region, unsigned long long n);
+void expint_stats_count_gamma_inc(int branch);
+void expint_stats_count_cf(int iterations);
+void expint_stats_count_recursion(int steps);
+unsigned long long expint_stats_clock(void);
+void expint_stats_time(int entry, unsigned long long start);
+
+/* Count only when the instrumentation is enabled */
+#define EXPINT_STATS(call) do { if (EXPINT_STATS_ON) call; } while (0)
+
+/* Memoization; see cache.c. The tags identify the function, along
+ * with the order, the scaling and the precision; they are never 0. */
+extern int expint_cache_on;
+int expint_cache_lookup(uint64_t tag, double a, double x, double *res);
+void expint_cache_store(uint64_t tag, double a, double x, double res);
+#define EXPINT_CACHE_TAG_GAMMA_INC(scale, log, prec)			\
+    (1 | (uint64_t) (prec) << 2 | (uint64_t) ((scale) != 0) << 3 |	\
+     (uint64_t) ((log) != 0) << 4)
+#define EXPINT_CACHE_TAG_EN(n, scale, prec)				\
+    (2 | (uint64_t) (prec) << 2 | (uint64_t) ((scale) != 0) << 3 |	\
+     (uint64_t) (uint32_t) (n) << 4)
+
+/* Root of the decreasing function g of x > 0 returning its value and
+ * storing its first two derivatives, by safeguarded Halley iterations
+ * from 'x'; see expint.c */
+typedef double (*expint_logfun)(double x, const void *par,
+				double *d1, double *d2);
+double expint_solve(expint_logfun g, const void *par, double x);
+
+/* Data structure for a Chebyshev series over a given interval */
+struct cheb_series_struct {
+    double * c;   /* coefficients                */
+    int order;    /* order of expansion          */
+    double a;     /* lower interval point        */
+    double b;     /* upper interval point        */
+    int order_sp; /* effective single precision order */
+};
+typedef struct cheb_series_struct cheb_series;
+
+/* Adapted from specfun/cheb_eval.c in GSL sources; the expansion is
+ * truncated at its single precision order when 'prec' is
+ * EXPINT_PREC_SINGLE, as in cheb_eval_mode_e() */
+static inline double cheb_eval(const cheb_series * cs,
+			       const double x, int prec)
+{
+    int j;
+    double d  = 0.0;
+    double dd = 0.0;
+
+    double y  = (2.0*x - cs->a - cs->b) / (cs->b - cs->a);
+    double y2 = 2.0 * y;
+
+    const int order = (prec == EXPINT_PREC_SINGLE) ? cs->order_sp : cs->order;
+
+    for(j = order; j >= 1; j--)
+    {
+	double temp = d;
+	d = y2*d - dd + cs->c[j];
+	dd = temp;
+    }
+
+    return y*d - dd + 0.5 * cs->c[0];
+}
+
+/* Same as cheb_eval() with an estimate of the absolute error stored
+ * in 'err': the rounding errors of the recurrence, as in
+ * cheb_eval_e() of GSL, plus the truncation error, bounded by the sum
+ * of the absolute values of the coefficients left out (by the last
+ * coefficient at full order) */
+static inline double cheb_eval_e(const cheb_series * cs,
+				 const double x, int prec, double *err)
+{
+    int j;
+    double d  = 0.0;
+    double dd = 0.0;
+    double e  = 0.0;
+
+    double y  = (2.0*x - cs->a - cs->b) / (cs->b - cs->a);
+    double y2 = 2.0 * y;
+
+    const int order = (prec == EXPINT_PREC_SINGLE) ? cs->order_sp : cs->order;
+
+    for(j = order; j >= 1; j--)
+    {
+	double temp = d;
+	d = y2*d - dd + cs->c[j];
+	e += fabs(y2*temp) + fabs(dd) + fabs(cs->c[j]);
+	dd = temp;
+    }
+
+    {
+	double temp = d;
+	d = y*d - dd + 0.5 * cs->c[0];
+	e += fabs(y*temp) + fabs(dd) + 0.5 * fabs(cs->c[0]);
+    }
+
+    *err = DBL_EPSILON * e;
+    if (order == cs->order)
+	*err += fabs(cs->c[order]);
+    else
+	for (j = order + 1; j <= cs->order; j++)
+	    *err += fabs(cs->c[j]);
+
+    return d;
+}
+
+/* Constants (taken from gsl_machine.h in GSL sources) */
+#define LOG_DBL_MIN   (-7.0839641853226408e+02)
+#define LOG_DBL_MAX    7.0978271289338397e+02
+#define EULER_CNST     0.57721566490153286060651209008
+
+/* Macros */
+#define E1_IS_ODD(n)  ((n) & 1)	/* taken from GSL */
@@ -0,0 +1,1393 @@
+/*  == expint: Exponential Integral and Incomplete Gamma Function ==
+ *
+ *  Functions to compute the exponential integral functions
+ *
+ *     E_1(x) = int_x^infty exp(-t)/t dt,
+ *     E_2(x) = int_x^infty exp(-t)/t^2 dt
+ *
+ *  and
+ *
+ *     E_n(x) = int_x^infty exp(-t)/t^n dt.
+ *
+ *  This file is part of libexpint, the core of package expint that
+ *  does not depend on R; see the Makefile in this directory.
+ *
+ *  Copyright (C) 2016-2026 Vincent Goulet
+ *
+ *  The code in part IMPLEMENTATION is derived from the GNU Scientific
+ *  Library (GSL) v2.2.1 <https://www.gnu.org/software/gsl/>
+ *
+ *  Copyright (C) 2007 Brian Gough
+ *  Copyright (C) 1996, 1997, 1998, 1999, 2000, 2001, 2002 Gerard Jungman
+ *
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU General Public License as
+ *  published by the Free Software Foundation; either version 3 of the
+ *  License, or (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ *  General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ *  02110-1301, USA.
+ *
+ *  AUTHOR for the GSL: G. Jungman
+ *  AUTHOR for expint: Vincent Goulet <vincent.goulet@act.ulaval.ca>
+ *                     with much indirect help from the R Core Team
+ */
+
+#include <math.h>
+#include <float.h>
+#include <Rmath.h>
+#include "core.h"
+
+/*
+ *  IMPLEMENTATION OF THE WORKHORSES
+ *
+ *  Adapted from "special functions" material in the GSL. The data
+ *  structure for the Chebyshev series and cheb_eval() are in core.h.
+ *
+ */
+
+
+/*
+ Chebyshev expansions: based on SLATEC e1.f, W. Fullerton
+
+ Series for AE11       on the interval -1.00000D-01 to  0.
+                                        with weighted error   1.76E-17
+                                         log weighted error  16.75
+                               significant figures required  15.70
+                                    decimal places required  17.55
+
+
+ Series for AE12       on the interval -2.50000D-01 to -1.00000D-01
+                                        with weighted error   5.83E-17
+                                         log weighted error  16.23
+                               significant figures required  15.76
+                                    decimal places required  16.93
+
+
+ Series for E11        on the interval -4.00000D+00 to -1.00000D+00
+                                        with weighted error   1.08E-18
+                                         log weighted error  17.97
+                               significant figures required  19.02
+                                    decimal places required  18.61
+
+
+ Series for E12        on the interval -1.00000D+00 to  1.00000D+00
+                                        with weighted error   3.15E-18
+                                         log weighted error  17.50
+                        approx significant figures required  15.8
+                                    decimal places required  18.10
+
+
+ Series for AE13       on the interval  2.50000D-01 to  1.00000D+00
+                                        with weighted error   2.34E-17
+                                         log weighted error  16.63
+                               significant figures required  16.14
+                                    decimal places required  17.33
+
+
+ Series for AE14       on the interval  0.          to  2.50000D-01
+                                        with weighted error   5.41E-17
+                                         log weighted error  16.27
+                               significant figures required  15.38
+                                    decimal places required  16.97
+*/
+
+static double AE11_data[39] = {
+   0.121503239716065790,
+  -0.065088778513550150,
+   0.004897651357459670,
+  -0.000649237843027216,
+   0.000093840434587471,
+   0.000000420236380882,
+  -0.000008113374735904,
+   0.000002804247688663,
+   0.000000056487164441,
+  -0.000000344809174450,
+   0.000000058209273578,
+   0.000000038711426349,
+  -0.000000012453235014,
+  -0.000000005118504888,
+   0.000000002148771527,
+   0.000000000868459898,
+  -0.000000000343650105,
+  -0.000000000179796603,
+   0.000000000047442060,
+   0.000000000040423282,
+  -0.000000000003543928,
+  -0.000000000008853444,
+  -0.000000000000960151,
+   0.000000000001692921,
+   0.000000000000607990,
+  -0.000000000000224338,
+  -0.000000000000200327,
+  -0.000000000000006246,
+   0.000000000000045571,
+   0.000000000000016383,
+  -0.000000000000005561,
+  -0.000000000000006074,
+  -0.000000000000000862,
+   0.000000000000001223,
+   0.000000000000000716,
+  -0.000000000000000024,
+  -0.000000000000000201,
+  -0.000000000000000082,
+   0.000000000000000017
+};
+static cheb_series AE11_cs = {
+  AE11_data,
+  38,
+  -1, 1,
+  20
+};
+
+static double AE12_data[25] = {
+   0.582417495134726740,
+  -0.158348850905782750,
+  -0.006764275590323141,
+   0.005125843950185725,
+   0.000435232492169391,
+  -0.000143613366305483,
+  -0.000041801320556301,
+  -0.000002713395758640,
+   0.000001151381913647,
+   0.000000420650022012,
+   0.000000066581901391,
+   0.000000000662143777,
+  -0.000000002844104870,
+  -0.000000000940724197,
+  -0.000000000177476602,
+  -0.000000000015830222,
+   0.000000000002905732,
+   0.000000000001769356,
+   0.000000000000492735,
+   0.000000000000093709,
+   0.000000000000010707,
+  -0.000000000000000537,
+  -0.000000000000000716,
+  -0.000000000000000244,
+  -0.000000000000000058
+};
+static cheb_series AE12_cs = {
+  AE12_data,
+  24,
+  -1, 1,
+  15
+};
+
+static double E11_data[19] = {
+  -16.11346165557149402600,
+    7.79407277874268027690,
+   -1.95540581886314195070,
+    0.37337293866277945612,
+   -0.05692503191092901938,
+    0.00721107776966009185,
+   -0.00078104901449841593,
+    0.00007388093356262168,
+   -0.00000620286187580820,
+    0.00000046816002303176,
+   -0.00000003209288853329,
+    0.00000000201519974874,
+   -0.00000000011673686816,
+    0.00000000000627627066,
+   -0.00000000000031481541,
+    0.00000000000001479904,
+   -0.00000000000000065457,
+    0.00000000000000002733,
+   -0.00000000000000000108
+};
+static cheb_series E11_cs = {
+  E11_data,
+  18,
+  -1, 1,
+  13
+};
+
+static double E12_data[16] = {
+  -0.03739021479220279500,
+   0.04272398606220957700,
+  -0.13031820798497005440,
+   0.01441912402469889073,
+  -0.00134617078051068022,
+   0.00010731029253063780,
+  -0.00000742999951611943,
+   0.00000045377325690753,
+  -0.00000002476417211390,
+   0.00000000122076581374,
+  -0.00000000005485141480,
+   0.00000000000226362142,
+  -0.00000000000008635897,
+   0.00000000000000306291,
+  -0.00000000000000010148,
+   0.00000000000000000315
+};
+static cheb_series E12_cs = {
+  E12_data,
+  15,
+  -1, 1,
+  10
+};
+
+static double AE13_data[25] = {
+  -0.605773246640603460,
+  -0.112535243483660900,
+   0.013432266247902779,
+  -0.001926845187381145,
+   0.000309118337720603,
+  -0.000053564132129618,
+   0.000009827812880247,
+  -0.000001885368984916,
+   0.000000374943193568,
+  -0.000000076823455870,
+   0.000000016143270567,
+  -0.000000003466802211,
+   0.000000000758754209,
+  -0.000000000168864333,
+   0.000000000038145706,
+  -0.000000000008733026,
+   0.000000000002023672,
+  -0.000000000000474132,
+   0.000000000000112211,
+  -0.000000000000026804,
+   0.000000000000006457,
+  -0.000000000000001568,
+   0.000000000000000383,
+  -0.000000000000000094,
+   0.000000000000000023
+};
+static cheb_series AE13_cs = {
+  AE13_data,
+  24,
+  -1, 1,
+  15
+};
+
+static double AE14_data[26] = {
+  -0.18929180007530170,
+  -0.08648117855259871,
+   0.00722410154374659,
+  -0.00080975594575573,
+   0.00010999134432661,
+  -0.00001717332998937,
+   0.00000298562751447,
+  -0.00000056596491457,
+   0.00000011526808397,
+  -0.00000002495030440,
+   0.00000000569232420,
+  -0.00000000135995766,
+   0.00000000033846628,
+  -0.00000000008737853,
+   0.00000000002331588,
+  -0.00000000000641148,
+   0.00000000000181224,
+  -0.00000000000052538,
+   0.00000000000015592,
+  -0.00000000000004729,
+   0.00000000000001463,
+  -0.00000000000000461,
+   0.00000000000000148,
+  -0.00000000000000048,
+   0.00000000000000016,
+  -0.00000000000000005
+};
+static cheb_series AE14_cs = {
+  AE14_data,
+  25,
+  -1, 1,
+  13
+};
+
+/* Chebyshev expansion of expint_E1_impl(), with an estimate of its
+ * absolute error stored in 'err' unless it is NULL */
+static inline double E1_cheb(const cheb_series * cs, double x, int prec,
+			     double *err)
+{
+    return (err == NULL) ? cheb_eval(cs, x, prec) :
+	cheb_eval_e(cs, x, prec, err);
+}
+
+/* Estimate of the absolute error of s (t + cheb), as in GSL: the
+ * error 'cerr' of the expansion and 'terr' of the other terms, plus
+ * the rounding errors of the product, and of the exponential in the
+ * prefactor 's' when 'x' is its argument */
+#define E1_ERR(s, cerr, terr, x, res)			\
+    (fabs(s) * ((cerr) + (terr)) +			\
+     2.0 * (fabs(x) + 1.0) * DBL_EPSILON * fabs(res))
+
+/* Adapted from specfun/expint.c::expint_E1_impl in GSL sources. The
+ * estimate of the absolute error is stored in 'err' unless it is
+ * NULL. */
+static double expint_E1_impl(double x, int scale, int prec, double *err)
+{
+    double cerr = 0.0, res;
+
+    if (isnan(x))
+    {
+	EXPINT_STATS(expint_stats_count_E1(EXPINT_STATS_E1_OTHER, 1));
+	if (err != NULL) *err = x;
+	return x;
+    }
+
+    const double xmaxt = -LOG_DBL_MIN;       /* XMAXT = -LOG(DBL_MIN) */
+    const double xmax  = xmaxt - log(xmaxt); /* XMAX = XMAXT - LOG(XMAXT) */
+
+    if (x < -xmax && !scale)
+    {
+	EXPINT_STATS(expint_stats_count_E1(EXPINT_STATS_E1_OTHER, 1));
+	expint_signal(EXPINT_E1_OVERFLOW);
+	if (err != NULL) *err = INFINITY;
+	return INFINITY;
+    }
+    else if (x <= -10.0)
+    {
+	EXPINT_STATS(expint_stats_count_E1(EXPINT_STATS_E1_AE11, 1));
+	const double s = 1.0/x * (scale ? 1.0 : exp(-x));
+	const double cheb = E1_cheb(&AE11_cs, 20.0/x+1.0, prec, err ? &cerr : NULL);
+	res = s * (1.0 + cheb);
+	if (err != NULL) *err = E1_ERR(s, cerr, 0.0, scale ? 0.0 : x, res);
+	return res;
+    }
+    else if (x <= -4.0)
+    {
+	EXPINT_STATS(expint_stats_count_E1(EXPINT_STATS_E1_AE12, 1));
+	const double s = 1.0/x * (scale ? 1.0 : exp(-x));
+	const double cheb = E1_cheb(&AE12_cs, (40.0/x+7.0)/3.0, prec, err ? &cerr : NULL);
+	res = s * (1.0 + cheb);
+	if (err != NULL) *err = E1_ERR(s, cerr, 0.0, scale ? 0.0 : x, res);
+	return res;
+    }
+    else if (x <= -1.0)
+    {
+	EXPINT_STATS(expint_stats_count_E1(EXPINT_STATS_E1_E11, 1));
+	const double s = (scale ? exp(x) : 1.0);
+	const double ln_term = -log(fabs(x));
+	const double cheb = E1_cheb(&E11_cs, (2.0*x+5.0)/3.0, prec, err ? &cerr : NULL);
+	res = s * (ln_term + cheb);
+	if (err != NULL)
+	    *err = E1_ERR(s, cerr, DBL_EPSILON * fabs(ln_term), 0.0, res);
+	return res;
+    }
+    else if (x == 0.0)
+    {
+	EXPINT_STATS(expint_stats_count_E1(EXPINT_STATS_E1_OTHER, 1));
+	if (err != NULL) *err = NAN;
+	return NAN;
+    }
+    else if (x <= 1.0)
+    {
+	EXPINT_STATS(expint_stats_count_E1(EXPINT_STATS_E1_E12, 1));
+	const double s = (scale ? exp(x) : 1.0);
+	const double ln_term = -log(fabs(x));
+	const double cheb = E1_cheb(&E12_cs, x, prec, err ? &cerr : NULL);
+	res = s * (ln_term - 0.6875 + x + cheb);
+	if (err != NULL)
+	    *err = E1_ERR(s, cerr, DBL_EPSILON * fabs(ln_term), 0.0, res);
+	return res;
+    }
+    else if (x <= 4.0)
+    {
+	EXPINT_STATS(expint_stats_count_E1(EXPINT_STATS_E1_AE13, 1));
+	const double s = 1.0/x * (scale ? 1.0 : exp(-x));
+	const double cheb = E1_cheb(&AE13_cs, (8.0/x-5.0)/3.0, prec, err ? &cerr : NULL);
+	res = s * (1.0 + cheb);
+	if (err != NULL) *err = E1_ERR(s, cerr, 0.0, scale ? 0.0 : x, res);
+	return res;
+    }
+    else if (x <= xmax || scale)
+    {
+	EXPINT_STATS(expint_stats_count_E1(EXPINT_STATS_E1_AE14, 1));
+	const double s = 1.0/x * (scale ? 1.0 : exp(-x));
+	const double cheb = E1_cheb(&AE14_cs, 8.0/x-1.0, prec, err ? &cerr : NULL);
+	res = s * (1.0 +  cheb);
+	if (res == 0.0)
+	{
+	    expint_signal(EXPINT_E1_UNDERFLOW);
+	    if (err != NULL) *err = DBL_MIN;
+	    return 0.0;
+	}
+	if (err != NULL) *err = E1_ERR(s, cerr, 0.0, scale ? 0.0 : x, res);
+	return res;
+    }
+    else {
+	EXPINT_STATS(expint_stats_count_E1(EXPINT_STATS_E1_OTHER, 1));
+	expint_signal(EXPINT_E1_UNDERFLOW);
+	if (err != NULL) *err = DBL_MIN;
+	return 0.0;
+    }
+}
+
+double expint_E1(double x, int scale)
+{
+    unsigned long long start;
+    double res;
+
+    if (!EXPINT_STATS_ON)
+	return expint_E1_impl(x, scale, expint_prec, NULL);
+
+    start = expint_stats_clock();
+    res = expint_E1_impl(x, scale, expint_prec, NULL);
+    expint_stats_time(EXPINT_STATS_E1, start);
+    return res;
+}
+
+double expint_E1_e(double x, int scale, double *err)
+{
+    unsigned long long start = EXPINT_STATS_ON ? expint_stats_clock() : 0;
+    double res = expint_E1_impl(x, scale, expint_prec, err);
+
+    EXPINT_STATS(expint_stats_time(EXPINT_STATS_E1, start));
+    return res;
+}
+
+/* Adapted from specfun/expint.c::expint_E2_impl in GSL sources. The
+ * estimate of the absolute error is stored in 'err' unless it is
+ * NULL. */
+static double expint_E2_impl(double x, int scale, double *err)
+{
+    if (isnan(x))
+    {
+	if (err != NULL) *err = x;
+	return x;
+    }
+
+    const double xmaxt = -LOG_DBL_MIN;
+    const double xmax  = xmaxt - log(xmaxt);
+
+    if (x < -xmax && !scale)
+    {
+	expint_signal(EXPINT_E2_OVERFLOW);
+	if (err != NULL) *err = INFINITY;
+	return INFINITY;
+    }
+    else if (x == 0.0)
+    {
+	if (err != NULL) *err = 0.0;
+	return 1.0;
+    }
+    else if (x < 100.0)
+    {
+	const double ex = (scale ? 1.0 : exp(-x));
+	double res, e1err;
+
+	if (err == NULL)
+	    return ex - x * expint_E1(x, scale);
+
+	res = ex - x * expint_E1_impl(x, scale, expint_prec, &e1err);
+	*err = DBL_EPSILON * fabs(ex) + fabs(x) * e1err
+	    + 2.0 * DBL_EPSILON * fabs(res);
+	return res;
+    }
+    else if (x < xmax || scale)
+    {
+	const double s = (scale ? 1.0 : exp(-x));
+	const double c1  = -2.0;
+	const double c2  =  6.0;
+	const double c3  = -24.0;
+	const double c4  =  120.0;
+	const double c5  = -720.0;
+	const double c6  =  5040.0;
+	const double c7  = -40320.0;
+	const double c8  =  362880.0;
+	const double c9  = -3628800.0;
+	const double c10 =  39916800.0;
+	const double c11 = -479001600.0;
+	const double c12 =  6227020800.0;
+	const double c13 = -87178291200.0;
+	const double y = 1.0/x;
+	const double sum6 = c6+y*(c7+y*(c8+y*(c9+y*(c10+y*(c11+y*(c12+y*c13))))));
+	const double sum  = y*(c1+y*(c2+y*(c3+y*(c4+y*(c5+y*sum6)))));
+	double res = s * (1.0 + sum)/x;
+	if (res == 0.0)
+	{
+	    expint_signal(EXPINT_E2_UNDERFLOW);
+	    if (err != NULL) *err = DBL_MIN;
+	    return 0.0;
+	}
+	/* rounding errors and first term left out, 14! y^14 */
+	if (err != NULL)
+	    *err = 2.0 * ((scale ? 0.0 : x) + 1.0) * DBL_EPSILON * fabs(res)
+		+ 1307674368000.0 * R_pow_di(y, 14) * fabs(res);
+	return res;
+    }
+    else {
+	expint_signal(EXPINT_E2_UNDERFLOW);
+	if (err != NULL) *err = DBL_MIN;
+	return 0.0;
+    }
+}
+
+double expint_E2(double x, int scale)
+{
+    unsigned long long start;
+    double res;
+
+    if (!EXPINT_STATS_ON)
+	return expint_E2_impl(x, scale, NULL);
+
+    start = expint_stats_clock();
+    res = expint_E2_impl(x, scale, NULL);
+    expint_stats_time(EXPINT_STATS_E2, start);
+    return res;
+}
+
+double expint_E2_e(double x, int scale, double *err)
+{
+    unsigned long long start = EXPINT_STATS_ON ? expint_stats_clock() : 0;
+    double res = expint_E2_impl(x, scale, err);
+
+    EXPINT_STATS(expint_stats_time(EXPINT_STATS_E2, start));
+    return res;
+}
+
+/*
+ *  BATCH EVALUATION
+ *
+ *  The R interfaces to E_1 and E_2 evaluate long vectors. Rather than
+ *  calling expint_E1() once per element, the batch routines below
+ *  process blocks of EXPINT_BATCH values: a first pass sorts the
+ *  arguments by interval of the Chebyshev expansions, then each
+ *  expansion is evaluated on all of its arguments at once, four or
+ *  eight at a time on processors with AVX2 or AVX-512 units. The
+ *  kernel is selected at load time by expint_batch_init().
+ *
+ *  The vector kernels perform the same floating point operations, in
+ *  the same order and without fused multiply-add, as cheb_eval();
+ *  the batch routines thus return results identical (0 ulp) to those
+ *  of expint_E1() and expint_E2(). The prefactors exp(-x) and log(|x|)
+ *  are still computed with the scalar routines of the C library for
+ *  the same reason. Arguments outside the range of the expansions
+ *  (NaN, 0, overflow and underflow regions) go through the scalar
+ *  routines.
+ *
+ */
+
+#define EXPINT_BATCH 256	/* number of values per block */
+
+/* Chebyshev expansions used in expint_E1(), in the order of the
+ * branches */
+enum { E1_AE11, E1_AE12, E1_E11, E1_E12, E1_AE13, E1_AE14, E1_NSERIES };
+static const cheb_series *E1_series[E1_NSERIES] = {
+    &AE11_cs, &AE12_cs, &E11_cs, &E12_cs, &AE13_cs, &AE14_cs
+};
+
+/* Clenshaw recurrence of cheb_eval() applied to 'n' arguments 'y'
+ * already mapped to [-1, 1], up to degree 'order'. */
+static void cheb_eval_n_generic(const cheb_series * cs, int order,
+				const double *y, double *res, int n)
+{
+    int i, j;
+    double d[EXPINT_BATCH], dd[EXPINT_BATCH];
+
+    for (i = 0; i < n; i++)
+	d[i] = dd[i] = 0.0;
+
+    for (j = order; j >= 1; j--)
+    {
+	const double cj = cs->c[j];
+	for (i = 0; i < n; i++)
+	{
+	    double temp = d[i];
+	    d[i] = 2.0 * y[i] * d[i] - dd[i] + cj;
+	    dd[i] = temp;
+	}
+    }
+
+    for (i = 0; i < n; i++)
+	res[i] = y[i] * d[i] - dd[i] + 0.5 * cs->c[0];
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HAVE_CPU_DISPATCH
+#include <immintrin.h>
+
+/* Forbid the contraction of multiplications and additions into fused
+ * multiply-add instructions (available with AVX-512) in the vector
+ * kernels, as this would change the results. */
+#ifdef __clang__
+#define NO_FP_CONTRACT
+#define FP_CONTRACT_OFF _Pragma("clang fp contract(off)")
+#else
+#define NO_FP_CONTRACT __attribute__((optimize("fp-contract=off")))
+#define FP_CONTRACT_OFF
+#endif
+
+/* Same as cheb_eval_n_generic() with two AVX2 registers (8 values)
+ * per pass to hide the latency of the recurrence */
+__attribute__((target("avx2"))) NO_FP_CONTRACT
+static void cheb_eval_n_avx2(const cheb_series * cs, int order,
+			     const double *y, double *res, int n)
+{
+    FP_CONTRACT_OFF
+    int i, j;
+    const __m256d c0 = _mm256_set1_pd(0.5 * cs->c[0]);
+
+    for (i = 0; i + 8 <= n; i += 8)
+    {
+	__m256d ya = _mm256_loadu_pd(y + i), yb = _mm256_loadu_pd(y + i + 4);
+	__m256d y2a = _mm256_add_pd(ya, ya), y2b = _mm256_add_pd(yb, yb);
+	__m256d da = _mm256_setzero_pd(), dda = _mm256_setzero_pd();
+	__m256d db = _mm256_setzero_pd(), ddb = _mm256_setzero_pd();
+
+	for (j = order; j >= 1; j--)
+	{
+	    const __m256d cj = _mm256_set1_pd(cs->c[j]);
+	    __m256d ta = da, tb = db;
+	    da = _mm256_add_pd(_mm256_sub_pd(_mm256_mul_pd(y2a, da), dda), cj);
+	    db = _mm256_add_pd(_mm256_sub_pd(_mm256_mul_pd(y2b, db), ddb), cj);
+	    dda = ta;
+	    ddb = tb;
+	}
+
+	_mm256_storeu_pd(res + i,
+			 _mm256_add_pd(_mm256_sub_pd(_mm256_mul_pd(ya, da), dda), c0));
+	_mm256_storeu_pd(res + i + 4,
+			 _mm256_add_pd(_mm256_sub_pd(_mm256_mul_pd(yb, db), ddb), c0));
+    }
+
+    if (i < n)
+	cheb_eval_n_generic(cs, order, y + i, res + i, n - i);
+}
+
+/* Same with two AVX-512 registers (16 values) per pass */
+__attribute__((target("avx512f"))) NO_FP_CONTRACT
+static void cheb_eval_n_avx512(const cheb_series * cs, int order,
+			       const double *y, double *res, int n)
+{
+    FP_CONTRACT_OFF
+    int i, j;
+    const __m512d c0 = _mm512_set1_pd(0.5 * cs->c[0]);
+
+    for (i = 0; i + 16 <= n; i += 16)
+    {
+	__m512d ya = _mm512_loadu_pd(y + i), yb = _mm512_loadu_pd(y + i + 8);
+	__m512d y2a = _mm512_add_pd(ya, ya), y2b = _mm512_add_pd(yb, yb);
+	__m512d da = _mm512_setzero_pd(), dda = _mm512_setzero_pd();
+	__m512d db = _mm512_setzero_pd(), ddb = _mm512_setzero_pd();
+
+	for (j = order; j >= 1; j--)
+	{
+	    const __m512d cj = _mm512_set1_pd(cs->c[j]);
+	    __m512d ta = da, tb = db;
+	    da = _mm512_add_pd(_mm512_sub_pd(_mm512_mul_pd(y2a, da), dda), cj);
+	    db = _mm512_add_pd(_mm512_sub_pd(_mm512_mul_pd(y2b, db), ddb), cj);
+	    dda = ta;
+	    ddb = tb;
+	}
+
+	_mm512_storeu_pd(res + i,
+			 _mm512_add_pd(_mm512_sub_pd(_mm512_mul_pd(ya, da), dda), c0));
+	_mm512_storeu_pd(res + i + 8,
+			 _mm512_add_pd(_mm512_sub_pd(_mm512_mul_pd(yb, db), ddb), c0));
+    }
+
+    if (i < n)
+	cheb_eval_n_avx2(cs, order, y + i, res + i, n - i);
+}
+#endif /* HAVE_CPU_DISPATCH */
+
+/* Kernel used by the batch routines; see expint_batch_init() */
+static void cheb_eval_n_resolve(const cheb_series *, int, const double *,
+				double *, int);
+static void (*cheb_eval_n)(const cheb_series *, int, const double *,
+			   double *, int) = cheb_eval_n_resolve;
+
+/* Select the kernel according to the features of the processor.
+ * Called from R_init_expint() in the package; otherwise the kernel is
+ * selected on first use. */
+void expint_batch_init(void)
+{
+    void (*kernel)(const cheb_series *, int, const double *, double *, int)
+	= cheb_eval_n_generic;
+
+#ifdef HAVE_CPU_DISPATCH
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+	kernel = cheb_eval_n_avx512;
+    else if (__builtin_cpu_supports("avx2"))
+	kernel = cheb_eval_n_avx2;
+#endif
+    cheb_eval_n = kernel;
+}
+
+static void cheb_eval_n_resolve(const cheb_series * cs, int order,
+				const double *y, double *res, int n)
+{
+    expint_batch_init();
+    cheb_eval_n(cs, order, y, res, n);
+}
+
+/* Evaluation of E_1 for a block of at most EXPINT_BATCH values; the
+ * arithmetic mirrors that of expint_E1() branch by branch */
+static void expint_E1_block(const double *x, double *y, int n, int scale,
+			    int prec)
+{
+    int i, k, m, cnt[E1_NSERIES] = {0};
+    int idx[E1_NSERIES][EXPINT_BATCH];
+    double t[E1_NSERIES][EXPINT_BATCH], r[EXPINT_BATCH];
+
+    const double xmaxt = -LOG_DBL_MIN;
+    const double xmax  = xmaxt - log(xmaxt);
+
+    /* Sort the arguments by interval */
+    for (i = 0; i < n; i++)
+    {
+	const double xi = x[i];
+	double u;
+
+	if (isnan(xi) || xi == 0.0 || (!scale && (xi < -xmax || xi > xmax)))
+	{
+	    y[i] = expint_E1(xi, scale);
+	    continue;
+	}
+	else if (xi <= -10.0)
+	{
+	    k = E1_AE11;
+	    u = 20.0/xi+1.0;
+	}
+	else if (xi <= -4.0)
+	{
+	    k = E1_AE12;
+	    u = (40.0/xi+7.0)/3.0;
+	}
+	else if (xi <= -1.0)
+	{
+	    k = E1_E11;
+	    u = (2.0*xi+5.0)/3.0;
+	}
+	else if (xi <= 1.0)
+	{
+	    k = E1_E12;
+	    u = xi;
+	}
+	else if (xi <= 4.0)
+	{
+	    k = E1_AE13;
+	    u = (8.0/xi-5.0)/3.0;
+	}
+	else
+	{
+	    k = E1_AE14;
+	    u = 8.0/xi-1.0;
+	}
+
+	/* map to [-1, 1] as in cheb_eval() */
+	const cheb_series *cs = E1_series[k];
+	idx[k][cnt[k]] = i;
+	t[k][cnt[k]++] = (2.0*u - cs->a - cs->b) / (cs->b - cs->a);
+    }
+
+    /* Evaluate each expansion on its arguments (the expansions are
+     * in the same order as the regions of the instrumentation) */
+    for (k = 0; k < E1_NSERIES; k++)
+    {
+	if (cnt[k] == 0)
+	    continue;
+
+	EXPINT_STATS(expint_stats_count_E1(k, cnt[k]));
+
+	cheb_eval_n(E1_series[k],
+		    (prec == EXPINT_PREC_SINGLE) ? E1_series[k]->order_sp
+						 : E1_series[k]->order,
+		    t[k], r, cnt[k]);
+
+	for (m = 0; m < cnt[k]; m++)
+	{
+	    const double xi = x[i = idx[k][m]];
+
+	    if (k == E1_E11)
+	    {
+		const double s = (scale ? exp(xi) : 1.0);
+		const double ln_term = -log(fabs(xi));
+		y[i] = s * (ln_term + r[m]);
+	    }
+	    else if (k == E1_E12)
+	    {
+		const double s = (scale ? exp(xi) : 1.0);
+		const double ln_term = -log(fabs(xi));
+		y[i] = s * (ln_term - 0.6875 + xi + r[m]);
+	    }
+	    else
+	    {
+		const double s = 1.0/xi * (scale ? 1.0 : exp(-xi));
+		y[i] = s * (1.0 + r[m]);
+		if (k == E1_AE14 && y[i] == 0.0)
+		    y[i] = expint_E1(xi, scale); /* underflow */
+	    }
+	}
+    }
+}
+
+/* Evaluation of E_2 for a block of at most EXPINT_BATCH values; E_1
+ * is computed in batch for the arguments that need it */
+static void expint_E2_block(const double *x, double *y, int n, int scale,
+			    int prec)
+{
+    int i, m = 0, idx[EXPINT_BATCH];
+    double t[EXPINT_BATCH], r[EXPINT_BATCH];
+
+    const double xmaxt = -LOG_DBL_MIN;
+    const double xmax  = xmaxt - log(xmaxt);
+
+    for (i = 0; i < n; i++)
+    {
+	const double xi = x[i];
+
+	if (isnan(xi) || xi == 0.0 || xi >= 100.0 || (xi < -xmax && !scale))
+	    y[i] = expint_E2(xi, scale);
+	else
+	{
+	    idx[m] = i;
+	    t[m++] = xi;
+	}
+    }
+
+    if (m == 0)
+	return;
+    expint_E1_block(t, r, m, scale, prec);
+
+    for (i = 0; i < m; i++)
+    {
+	const double ex = (scale ? 1.0 : exp(-t[i]));
+	y[idx[i]] = ex - t[i] * r[i];
+    }
+}
+
+/* Batch versions of expint_E1() and expint_E2(): evaluate the
+ * function at the 'n' values of 'x' and store the results in 'y' */
+void expint_E1_batch(const double *x, double *y, ptrdiff_t n, int scale)
+{
+    ptrdiff_t i;
+    const int prec = expint_prec;
+    unsigned long long start = EXPINT_STATS_ON ? expint_stats_clock() : 0;
+
+    for (i = 0; i < n; i += EXPINT_BATCH)
+	expint_E1_block(x + i, y + i,
+			(int) (n - i < EXPINT_BATCH ? n - i : EXPINT_BATCH),
+			scale, prec);
+
+    EXPINT_STATS(expint_stats_time(EXPINT_STATS_E1_BATCH, start));
+}
+
+void expint_E2_batch(const double *x, double *y, ptrdiff_t n, int scale)
+{
+    ptrdiff_t i;
+    const int prec = expint_prec;
+    unsigned long long start = EXPINT_STATS_ON ? expint_stats_clock() : 0;
+
+    for (i = 0; i < n; i += EXPINT_BATCH)
+	expint_E2_block(x + i, y + i,
+			(int) (n - i < EXPINT_BATCH ? n - i : EXPINT_BATCH),
+			scale, prec);
+
+    EXPINT_STATS(expint_stats_time(EXPINT_STATS_E2_BATCH, start));
+}
+
+/* Batch routines of the API. The 'n' values of 'x' are read with
+ * stride 'incx' (0 to recycle a single value); the results are
+ * stored contiguously in 'y'. In expint_En_vec(), the 'norder'
+ * values of 'order' are recycled over the 'n' values of 'x'. */
+static void expint_vec(const double *x, ptrdiff_t n, ptrdiff_t incx,
+		       int scale, double *y,
+		       void (*block)(const double *, double *, int, int, int))
+{
+    ptrdiff_t i, j;
+    int k, nb;
+    const int prec = expint_prec;
+    double t[EXPINT_BATCH];
+
+    if (incx == 1)
+    {
+	for (i = 0; i < n; i += EXPINT_BATCH)
+	    block(x + i, y + i,
+		  (int) (n - i < EXPINT_BATCH ? n - i : EXPINT_BATCH), scale,
+		  prec);
+	return;
+    }
+
+    for (i = 0, j = 0; i < n; i += EXPINT_BATCH)
+    {
+	nb = (int) (n - i < EXPINT_BATCH ? n - i : EXPINT_BATCH);
+	for (k = 0; k < nb; k++, j += incx)
+	    t[k] = x[j];
+	block(t, y + i, nb, scale, prec);
+    }
+}
+
+void expint_E1_vec(const double *x, ptrdiff_t n, ptrdiff_t incx,
+		   int scale, double *y)
+{
+    unsigned long long start = EXPINT_STATS_ON ? expint_stats_clock() : 0;
+
+    expint_vec(x, n, incx, scale, y, expint_E1_block);
+    EXPINT_STATS(expint_stats_time(EXPINT_STATS_E1_BATCH, start));
+}
+
+void expint_E2_vec(const double *x, ptrdiff_t n, ptrdiff_t incx,
+		   int scale, double *y)
+{
+    unsigned long long start = EXPINT_STATS_ON ? expint_stats_clock() : 0;
+
+    expint_vec(x, n, incx, scale, y, expint_E2_block);
+    EXPINT_STATS(expint_stats_time(EXPINT_STATS_E2_BATCH, start));
+}
+
+void expint_En_vec(const double *x, ptrdiff_t n, ptrdiff_t incx,
+		   const int *order, ptrdiff_t norder, int scale, double *y)
+{
+    ptrdiff_t i, ix, io;
+
+    if (norder == 1 && order[0] == 1)
+	expint_E1_vec(x, n, incx, scale, y);
+    else if (norder == 1 && order[0] == 2)
+	expint_E2_vec(x, n, incx, scale, y);
+    else
+    {
+	for (i = ix = io = 0; i < n; i++, ix += incx)
+	{
+	    y[i] = expint_En(x[ix], order[io], scale);
+	    if (++io == norder) io = 0;
+	}
+    }
+}
+
+/* Macro used in expint_En (only) */
+#define CHECK_UNDERFLOW(x, err)			\
+    if (fabs(x) < DBL_MIN) {			\
+        expint_signal(EXPINT_EN_UNDERFLOW);	\
+	if ((err) != NULL) *(err) = DBL_MIN;	\
+	return 0.0;				\
+    }						\
+
+/* Adapted from specfun/expint.c::expint_En_impl in GSL sources. The
+ * estimate of the absolute error is stored in 'err' unless it is
+ * NULL. */
+static double expint_En_impl(double x, int n, int scale, double *err)
+{
+    if (isnan(x))
+    {
+	if (err != NULL) *err = x;
+	return x;
+    }
+
+    if (n < 0)
+    {
+	if (err != NULL) *err = NAN;
+	return NAN;
+    }
+    else if (n == 0)
+    {
+	if (x == 0)
+	{
+	    if (err != NULL) *err = NAN;
+	    return NAN;
+	}
+	else
+	{
+	    double res = (scale ? 1.0 : exp(-x)) / x;
+	    CHECK_UNDERFLOW(res, err);
+	    if (err != NULL)
+		*err = 2.0 * ((scale ? 0.0 : fabs(x)) + 1.0) * DBL_EPSILON * fabs(res);
+	    return res;
+	}
+    }
+    else if (n == 1)
+	return (err == NULL) ? expint_E1(x, scale) :
+	    expint_E1_impl(x, scale, expint_prec, err);
+    else if (n == 2)
+	return (err == NULL) ? expint_E2(x, scale) :
+	    expint_E2_impl(x, scale, err);
+    else
+    {
+	if (x < 0)
+	{
+	    if (err != NULL) *err = NAN;
+	    return NAN;
+	}
+	if (x == 0)
+	{
+	    double res = (scale ? exp(x) : 1 ) * (1/(n-1.0));
+	    CHECK_UNDERFLOW(res, err);
+	    if (err != NULL) *err = DBL_EPSILON * res;
+	    return res;
+	}
+	else
+	{
+	    /* E_n(x) = x^(n-1) G(1-n,x) = e^{-x} S(1-n,x)/x with the
+	     * scaled function S of gamma_inc_scaled(), free of
+	     * overflow. The non memoized entry point is used since
+	     * E_n(x) itself is memoized by expint_En(). */
+	    double res, serr;
+
+	    res = gamma_inc_scaled_e((double) 1 - n, x,
+				     (err == NULL) ? NULL : &serr)/x;
+	    if (!scale)
+		res *= exp(-x);
+	    CHECK_UNDERFLOW(res, err);
+	    if (err != NULL)
+		*err = serr/x * (scale ? 1.0 : exp(-x))
+		    + ((scale ? 0.0 : x) + 2.0) * DBL_EPSILON * fabs(res);
+	    return res;
+	}
+    }
+}
+
+/* Value of expint_En_impl() taken from the cache, if enabled. Orders
+ * 0, 1 and 2 cost less than a look up. */
+static double expint_En_memo(double x, int n, int scale)
+{
+    uint64_t tag = EXPINT_CACHE_TAG_EN(n, scale, expint_prec);
+    unsigned int nsignals = expint_nsignals;
+    double res;
+
+    if (n <= 2)
+	return expint_En_impl(x, n, scale, NULL);
+    if (expint_cache_lookup(tag, 0.0, x, &res))
+	return res;
+
+    res = expint_En_impl(x, n, scale, NULL);
+    if (expint_nsignals == nsignals)
+	expint_cache_store(tag, 0.0, x, res);
+    return res;
+}
+
+double expint_En(double x, int n, int scale)
+{
+    unsigned long long start;
+    double res;
+
+    if (!EXPINT_STATS_ON)
+	return expint_cache_on ? expint_En_memo(x, n, scale) :
+	    expint_En_impl(x, n, scale, NULL);
+
+    start = expint_stats_clock();
+    res = expint_cache_on ? expint_En_memo(x, n, scale) :
+	expint_En_impl(x, n, scale, NULL);
+    expint_stats_time(EXPINT_STATS_EN, start);
+    return res;
+}
+
+/* Not memoized: the cache holds the values only */
+double expint_En_e(double x, int n, int scale, double *err)
+{
+    unsigned long long start = EXPINT_STATS_ON ? expint_stats_clock() : 0;
+    double res = expint_En_impl(x, n, scale, err);
+
+    EXPINT_STATS(expint_stats_time(EXPINT_STATS_EN, start));
+    return res;
+}
+
+/* Exponential integrals of orders 1, ..., 'nmax' at 'x', stored in
+ * 'y' with stride 'incy'.
+ *
+ * For x > 0, the scaled values F_n = e^x E_n(x) are computed from a
+ * single anchor at order n0 = floor(x) (clipped to [1, nmax]) with
+ * the recurrence relation
+ *
+ *   n F_{n+1} = 1 - x F_n,
+ *
+ * used forward for n >= n0 and backward for n < n0. In both
+ * directions, the errors are damped since x/n <= 1 above the anchor
+ * and n/x <= 1 below. The anchor is F_1 or F_2 for small 'x' and
+ * otherwise F_n = F(1-n, x)/x, where F is the continued fraction of
+ * gamma_inc_F_CF(). The cost is thus one anchor plus 'nmax' steps of
+ * the recurrence instead of O(nmax^2) operations with expint_En().
+ *
+ * Values for x <= 0 are computed order by order. */
+static void expint_En_seq_impl(double x, int nmax, int scale,
+			       double *y, ptrdiff_t incy)
+{
+    int k, n0;
+    double f, s;
+
+    if (nmax < 1)
+	return;
+
+    if (isnan(x) || x <= 0.0)
+    {
+	for (k = 0; k < nmax; k++)
+	    y[k * incy] = isnan(x) ? x : expint_En(x, k + 1, scale);
+	return;
+    }
+
+    n0 = (x < nmax) ? (int) x : nmax;
+    if (n0 < 1) n0 = 1;
+
+    if (n0 == 1)
+	f = expint_E1(x, 1);
+    else if (n0 == 2)
+	f = expint_E2(x, 1);
+    else
+	f = gamma_inc_F_CF(1.0 - n0, x)/x;
+    y[(n0 - 1) * incy] = f;
+
+    /* forward: F_{k+1} = (1 - x F_k)/k */
+    for (k = n0; k < nmax; k++)
+    {
+	f = (1.0 - x * f)/k;
+	y[k * incy] = f;
+    }
+
+    /* backward: F_k = (1 - k F_{k+1})/x */
+    f = y[(n0 - 1) * incy];
+    for (k = n0 - 1; k >= 1; k--)
+    {
+	f = (1.0 - k * f)/x;
+	y[(k - 1) * incy] = f;
+    }
+
+    if (scale)
+	return;
+
+    s = exp(-x);
+    for (k = 0; k < nmax; k++)
+    {
+	double res = s * y[k * incy];
+	if (res < DBL_MIN)
+	{
+	    expint_signal(EXPINT_EN_UNDERFLOW);
+	    res = 0.0;
+	}
+	y[k * incy] = res;
+    }
+}
+
+void expint_En_seq(double x, int nmax, int scale, double *y, ptrdiff_t incy)
+{
+    unsigned long long start = EXPINT_STATS_ON ? expint_stats_clock() : 0;
+
+    expint_En_seq_impl(x, nmax, scale, y, incy);
+    EXPINT_STATS(expint_stats_time(EXPINT_STATS_EN_SEQ, start));
+}
+
+/* Exponential integral E_n(x) and its derivatives of orders 1, ...,
+ * 'nderiv' with respect to 'x', stored in 'y' with stride 'incy'.
+ *
+ * Since d/dx E_n(x) = -E_{n-1}(x), the k-th derivative is (-1)^k
+ * E_{n-k}(x). The orders n - nderiv, ..., n >= 1 are obtained as in
+ * expint_En_seq() from a single anchor (here computed by expint_En())
+ * at the order closest to 'x', and the orders -j <= 0 from the
+ * closed form
+ *
+ *   E_{-j}(x) = (e^{-x} + j E_{-j+1}(x))/x,  E_0(x) = e^{-x}/x.
+ *
+ * When 'scale' is true, the derivatives are scaled by exp(x). */
+static void expint_En_deriv_impl(double x, int n, int nderiv, int scale,
+				 double *y, ptrdiff_t incy)
+{
+    int k, m, lo, n0;
+    double f, s;
+
+    if (nderiv < 0)
+	return;
+
+    if (isnan(x) || n < 0 || x == 0.0)
+    {
+	for (k = 0; k <= nderiv; k++)
+	    y[k * incy] = isnan(x) ? x :
+		(n - k >= 1) ? R_pow_di(-1.0, k) * expint_En(x, n - k, scale) :
+		NAN;
+	return;
+    }
+
+    /* scaled values F_m = e^x E_m(x) of the positive orders */
+    lo = (n - nderiv < 1) ? 1 : n - nderiv;
+    if (n >= 1)
+    {
+	if (x < 0.0)
+	    for (m = lo; m <= n; m++)
+		y[(n - m) * incy] = expint_En(x, m, 1);
+	else
+	{
+	    n0 = (x < n) ? (int) x : n;
+	    if (n0 < lo) n0 = lo;
+	    f = expint_En(x, n0, 1);
+	    y[(n - n0) * incy] = f;
+
+	    /* forward: F_{m+1} = (1 - x F_m)/m */
+	    for (m = n0; m < n; m++)
+	    {
+		f = (1.0 - x * f)/m;
+		y[(n - m - 1) * incy] = f;
+	    }
+
+	    /* backward: F_m = (1 - m F_{m+1})/x */
+	    f = y[(n - n0) * incy];
+	    for (m = n0 - 1; m >= lo; m--)
+	    {
+		f = (1.0 - m * f)/x;
+		y[(n - m) * incy] = f;
+	    }
+	}
+    }
+
+    /* non positive orders: F_{-j} = (1 + j F_{-j+1})/x */
+    for (f = 0.0, m = 0; m >= n - nderiv; m--)
+    {
+	f = (1.0 - m * f)/x;
+	if (m <= n)
+	    y[(n - m) * incy] = f;
+    }
+
+    s = scale ? 1.0 : exp(-x);
+    for (k = 0; k <= nderiv; k++)
+    {
+	double res = s * y[k * incy];
+	if (E1_IS_ODD(k))
+	    res = -res;
+	if (fabs(res) < DBL_MIN)
+	{
+	    expint_signal(EXPINT_EN_UNDERFLOW);
+	    res = 0.0;
+	}
+	y[k * incy] = res;
+    }
+}
+
+void expint_En_deriv(double x, int n, int nderiv, int scale,
+		     double *y, ptrdiff_t incy)
+{
+    unsigned long long start = EXPINT_STATS_ON ? expint_stats_clock() : 0;
+
+    expint_En_deriv_impl(x, n, nderiv, scale, y, incy);
+    EXPINT_STATS(expint_stats_time(EXPINT_STATS_EN_DERIV, start));
+}
+
+/*
+ *  INVERSES
+ *
+ *  Solutions in x of E_n(x) = y and G(a,x) = y. Both functions
+ *  decrease from their value at x = 0 to 0, so there is a single
+ *  root when 'y' lies in between. The equations are solved for the
+ *  logarithm of the functions as functions of log(x), nearly linear
+ *  for small x and at worst exponential for large x, with Halley's
+ *  method since the derivatives are at hand: d/dx E_n(x) =
+ *  -E_{n-1}(x) and d/dx G(a,x) = -x^(a-1) e^{-x}. The iterations keep
+ *  track of a bracket of the root; a step leaving the bracket is
+ *  replaced by a bisection on the log scale.
+ */
+double expint_solve(expint_logfun g, const void *par, double x)
+{
+    const int nmax = 100;
+    const double eps = 2.0 * EXPINT_EPS(expint_prec);
+    double lo = 0.0, hi = INFINITY, h, d1, d2, c, du, xn;
+    int k;
+
+    for (k = 0; k < nmax; k++)
+    {
+	h = g(x, par, &d1, &d2);
+	if (isnan(h))
+	    return NAN;
+	if (h == 0.0)
+	    return x;
+	if (h > 0.0)
+	    lo = x;
+	else
+	    hi = x;
+
+	/* derivatives with respect to u = log(x) */
+	d2 = x * (d1 + x * d2);
+	d1 *= x;
+
+	/* Newton step, corrected by the curvature when sensible */
+	du = -h/d1;
+	c = 1.0 + 0.5 * du * d2/d1;
+	if (c > 0.5)
+	    du /= c;
+	xn = x * exp(du);
+
+	if (fabs(du) <= eps || fabs(h) <= eps)
+	    return (xn > lo && xn < hi) ? xn : x;
+
+	/* bisection when the step leaves the bracket */
+	if (!(xn > lo && xn < hi))
+	{
+	    if (hi == INFINITY)
+		xn = (lo > 2.0) ? lo * lo : 2.0 * lo;
+	    else if (lo == 0.0)
+		xn = (hi < 0.5) ? fmax(hi * hi, DBL_MIN) : 0.5 * hi;
+	    else if (hi - lo <= eps * hi)
+		return x;
+	    else
+		xn = sqrt(lo) * sqrt(hi);
+	}
+	x = xn;
+    }
+
+    return x;
+}
+
+/* Logarithm of E_n(x)/y and its derivatives, from the scaled values
+ * F_m = e^x E_m(x) of orders n, n - 1 and n - 2: the derivatives are
+ * -F_{n-1}/F_n and F_{n-2}/F_n - (F_{n-1}/F_n)^2. */
+typedef struct {
+    int n;
+    double ly;			/* log(y) */
+} expint_En_inv_par;
+
+static double expint_En_logfun(double x, const void *par,
+			       double *d1, double *d2)
+{
+    const expint_En_inv_par *p = par;
+    double f[3], r;
+
+    expint_En_deriv(x, p->n, 2, 1, f, 1);
+    r = -f[1]/f[0];
+    *d1 = -r;
+    *d2 = f[2]/f[0] - r * r;
+    return log(f[0]) - x - p->ly;
+}
+
+/* Initial values: E_n(x) ~ e^{-x}/(x + n) for large x; for small x,
+ * E_0(x) ~ 1/x, E_1(x) ~ -gamma - log(x), E_2(x) ~ 1 + x log(x) and
+ * E_n(x) ~ 1/(n - 1) - x/(n - 2) for n > 2. The threshold between the
+ * two is about E_n(1). */
+static double expint_En_inv_impl(double y, int n)
+{
+    expint_En_inv_par par;
+    double t, x0;
+
+    if (isnan(y))
+	return y;
+
+    if (n < 0 || y < 0.0)
+	return NAN;
+    if (y == 0.0)
+	return INFINITY;
+    if (n >= 2 && y >= 1.0/(n - 1.0))
+	return (y == 1.0/(n - 1.0)) ? 0.0 : NAN;
+    if (y == INFINITY)
+	return 0.0;
+
+    t = -log(y);
+    if (y < exp(-1.0)/(1.0 + n))
+	x0 = t - log(t + n);
+    else if (n == 0)
+	x0 = 1.0/y;
+    else if (n == 1)
+	x0 = exp(-EULER_CNST - y);
+    else if (n == 2)
+	x0 = (1.0 - y)/(-log1p(-y));
+    else
+	x0 = (n - 2.0) * (1.0/(n - 1.0) - y);
+    if (!(x0 > DBL_MIN && x0 < DBL_MAX))
+	x0 = 1.0;
+
+    par.n = n;
+    par.ly = log(y);
+    return expint_solve(expint_En_logfun, &par, x0);
+}
+
+double expint_En_inv(double y, int n)
+{
+    unsigned long long start = EXPINT_STATS_ON ? expint_stats_clock() : 0;
+    double res = expint_En_inv_impl(y, n);
+
+    EXPINT_STATS(expint_stats_time(EXPINT_STATS_EN_INV, start));
+    return res;
+}
@@ -0,0 +1,1282 @@
+/*  == expint: Exponential Integral and Incomplete Gamma Function ==
+ *
+ *  Functions to compute the incomplete gamma function
+ *
+ *     G(a,x) = int_x^infty t^{a-1} exp(-t) dt
+ *
+ *  for 'a' real and 'x' >= 0. [This differs from 'pgamma' of base R
+ *  in that negative values of 'a' are admitted.]
+ *
+ *  This file is part of libexpint, the core of package expint that
+ *  does not depend on R; see the Makefile in this directory.
+ *
+ *  Copyright (C) 2016-2026 Vincent Goulet
+ *
+ *  The code in part IMPLEMENTATION is derived from the GNU Scientific
+ *  Library (GSL) v2.2.1 <https://www.gnu.org/software/gsl/>
+ *
+ *  Copyright (C) 2007 Brian Gough
+ *  Copyright (C) 1996, 1997, 1998, 1999, 2000, 2001, 2002 Gerard Jungman
+ *
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU General Public License as
+ *  published by the Free Software Foundation; either version 3 of the
+ *  License, or (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ *  General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ *  02110-1301, USA.
+ *
+ *  AUTHOR for the GSL: G. Jungman
+ *  AUTHOR for expint: Vincent Goulet <vincent.goulet@act.ulaval.ca>
+ *                     with much indirect help from the R Core Team
+ */
+
+#include <math.h>
+#include <float.h>
+#include <Rmath.h>
+#include "core.h"
+
+/* Error estimates: the routines of the R math library are taken as
+ * accurate to a few units in the last place, and exp(t) as having a
+ * relative error proportional to the magnitude 'm' of the terms of
+ * 't' */
+#define GAMMA_INC_RMATH_ERR(v)	(4.0 * DBL_EPSILON * fabs(v))
+#define GAMMA_INC_EXP_ERR(m)	((2.0 * (m) + 1.0) * DBL_EPSILON)
+
+/*
+ *  IMPLEMENTATION OF THE WORKHORSE
+ *
+ *  Adapted from "special functions" material in the GSL.
+ *
+ */
+
+/* Continued fraction which occurs in evaluation
+ * of Q(a,x) or Gamma(a,x).
+ *
+ *              1   (1-a)/x  1/x  (2-a)/x   2/x  (3-a)/x
+ *   F(a,x) =  ---- ------- ----- -------- ----- -------- ...
+ *             1 +   1 +     1 +   1 +      1 +   1 +
+ *
+ * Hans E. Plesser, 2002-01-22 (hans dot plesser at itf dot nlh dot no).
+ *
+ * Split out from gamma_inc_Q_CF() by GJ [Tue Apr  1 13:16:41 MST 2003].
+ * See gamma_inc_Q_CF() below.
+ *
+ * expint: the iterations stop at relative tolerance 'eps'.
+ */
+static double gamma_inc_F_CF_eps(double a, double x, double eps,
+				 double *err)
+{
+    const int    nmax  =  5000;
+    const double small =  R_pow_di(DBL_EPSILON, 3);
+
+    double hn = 1.0;           /* convergent */
+    double Cn = 1.0 / small;
+    double Dn = 1.0;
+    double delta = 1.0;
+    int n;
+
+    /* n == 1 has a_1, b_1, b_0 independent of a,x,
+       so that has been done by hand                */
+    for (n = 2 ; n < nmax ; n++)
+    {
+	double an;
+
+	if (E1_IS_ODD(n))
+	    an = 0.5 * (n - 1)/x;
+	else
+	    an = (0.5 * n - a)/x;
+
+	Dn = 1.0 + an * Dn;
+	if (fabs(Dn) < small)
+	    Dn = small;
+	Cn = 1.0 + an/Cn;
+	if (fabs(Cn) < small)
+	    Cn = small;
+	Dn = 1.0/Dn;
+	delta = Cn * Dn;
+	hn *= delta;
+	if (fabs(delta-1.0) < eps)
+	    break;
+    }
+
+    EXPINT_STATS(expint_stats_count_cf(n));
+    if (n == nmax)
+	expint_signal(EXPINT_CF_MAXITER);
+
+    /* rounding errors as in GSL, plus the last correction */
+    if (err != NULL)
+	*err = (2.0 * DBL_EPSILON + DBL_EPSILON * (2.0 + 0.5 * n) +
+		fabs(delta - 1.0)) * fabs(hn);
+
+    return hn;
+}
+
+double gamma_inc_F_CF(double a, double x)
+{
+    return gamma_inc_F_CF_eps(a, x, EXPINT_EPS(expint_prec), NULL);
+}
+
+/* Gamma function for -170.5 < a < 0, 'a' not an integer, by the
+ * reflection formula
+ *
+ *   Gamma(a) = pi/(sin(pi a) Gamma(1 - a)),
+ *
+ * with the argument of the sine reduced exactly. 'gammafn' is only
+ * called for positive arguments: for negative ones near an integer,
+ * it issues a warning, that may not be issued from a worker thread.
+ */
+static double gamma_neg(double a)
+{
+    const double n = nearbyint(a);
+    const double s = sin(M_PI * (a - n));
+
+    return M_PI/((fmod(n, 2.0) == 0.0 ? s : -s) * gammafn(1.0 - a));
+}
+
+/* Value G(a,0) = Gamma(a), by the reflection formula for a < -10,
+ * where 'gammafn' warns of a loss of precision near the integers */
+static double gamma_inc_x0(double a)
+{
+    return (a > -170.5 && a < -10.0 && a != nearbyint(a)) ?
+	gamma_neg(a) : gammafn(a);
+}
+
+/* Series for large negative non-integer 'a' and small 'x'.
+ *
+ *   Gamma(a,x) = Gamma(a) - x^a sum_{k=0}^infty (-x)^k/(k! (a+k)),
+ *
+ * the series being that of the lower incomplete gamma function. For
+ * x <= 0.25, about 20 terms suffice whatever the value of 'a', hence
+ * a cost independent of |a|. For a < -10, the sum is dominated by
+ * its first term 1/a, so there is no cancellation with Gamma(a),
+ * which is tiny in comparison; the latter is dropped altogether below
+ * the smallest argument of 'gammafn' (thereby also avoiding its
+ * underflow warning). The series is used for 'a' at a relative
+ * distance above 1e-7 from an integer; closer, the term 1/(a + k)
+ * for k = -a cancels with Gamma(a).
+ *
+ * expint: this replaces the downward recursion of GSL, whose cost
+ * and rounding errors grow linearly with |a|.
+ */
+static double gamma_inc_series_sum(double a, double x, double eps,
+				   double *err)
+{
+    const int nmax = 200;
+    const double m = -nearbyint(a);
+    double sum = 1.0/a, term = 1.0, t = 0.0, tm = 0.0, lm = 0.0;
+    int k;
+
+    for (k = 1; k < nmax; k++)
+    {
+	term *= -x/k;
+	t = term/(a + k);
+	sum += t;
+	if (fabs(t) < eps * fabs(sum))
+	    break;
+    }
+
+    /* the term of order k = -a, large when 'a' is near an integer,
+     * may be well past the point where the loop stopped; it is at
+     * most |term/(a + m)| */
+    if (k < m && fabs(term) > eps * fabs(sum) * fabs(a + m))
+    {
+	lm = m * log(x) - lgammafn(m + 1.0);
+	tm = exp(lm)/(a + m);
+	sum += (fmod(m, 2.0) == 0.0) ? tm : -tm;
+    }
+
+    /* alternating series: the last term bounds the remainder */
+    if (err != NULL)
+	*err = fabs(t) + GAMMA_INC_EXP_ERR(fabs(lm)) * fabs(tm) +
+	    2.0 * k * DBL_EPSILON * fabs(sum);
+    return sum;
+}
+
+static double gamma_inc_series(double a, double x, double eps, double *err)
+{
+    double serr, sum = gamma_inc_series_sum(a, x, eps, err ? &serr : NULL);
+    double g = (a > -170.0 ? gamma_neg(a) : 0.0), t, lt, res;
+
+    /* t = x^a sum, computed on the log scale to delay overflow */
+    lt = a * log(x) + log(fabs(sum));
+    t = exp(lt);
+    if (sum < 0.0)
+	t = -t;
+    res = g - t;
+    if (err != NULL)
+	*err = GAMMA_INC_RMATH_ERR(g) +
+	    fabs(t) * (serr/fabs(sum) +
+		       GAMMA_INC_EXP_ERR(fabs(a * log(x)) + fabs(log(fabs(sum))))) +
+	    DBL_EPSILON * fabs(res);
+    return res;
+}
+
+/* Uniform asymptotic expansion for large negative 'a' [DLMF 8.11.6]:
+ * with lambda = x/a,
+ *
+ *   Gamma(a,x) ~ x^a e^{-x} sum_{k=0}^infty (-a)^k b_k(lambda)/(x-a)^{2k+1},
+ *
+ * where b_0 = 1 and b_k(t) = t (1 - t) b'_{k-1}(t) + (2k - 1) t b_{k-1}(t).
+ * The expansion holds uniformly in x > 0 since x - a > 0. The ratio
+ * of consecutive terms is at most about 2k/|a|; for a <= -100, this
+ * bounds the number of terms by GAMMA_INC_UA_NTERMS whatever the
+ * value of x (near |a| or not), whereas the continued fraction needs
+ * a number of iterations depending on both arguments.
+ *
+ * The coefficients of b_k(t) = sum_{j=1}^k c_{kj} t^j (second order
+ * Eulerian numbers) are stored row by row in the table below. The
+ * polynomials are also evaluated at |lambda| to bound the terms since
+ * b_k(lambda) may vanish.
+ */
+#define GAMMA_INC_UA_NTERMS 20
+static const double gamma_inc_ua_b[] = {
+    /* b_1 */ 1.0,
+    /* b_2 */ 1.0, 2.0,
+    /* b_3 */ 1.0, 8.0, 6.0,
+    /* b_4 */ 1.0, 22.0, 58.0, 24.0,
+    /* b_5 */ 1.0, 52.0, 328.0, 444.0, 120.0,
+    /* b_6 */ 1.0, 114.0, 1452.0, 4400.0, 3708.0, 720.0,
+    /* b_7 */ 1.0, 240.0, 5610.0, 32120.0, 58140.0, 33984.0, 5040.0,
+    /* b_8 */ 1.0, 494.0, 19950.0, 195800.0, 644020.0, 785304.0, 341136.0,
+	40320.0,
+    /* b_9 */ 1.0, 1004.0, 67260.0, 1062500.0, 5765500.0, 12440064.0,
+	11026296.0, 3733920.0, 362880.0,
+    /* b_10 */ 1.0, 2026.0, 218848.0, 5326160.0, 44765000.0, 155357384.0,
+	238904904.0, 162186912.0, 44339040.0, 3628800.0,
+    /* b_11 */ 1.0, 4072.0, 695038.0, 25243904.0, 314369720.0,
+	1648384304.0, 4002695088.0, 4642163952.0, 2507481216.0, 568356480.0,
+	39916800.0,
+    /* b_12 */ 1.0, 8166.0, 2170626.0, 114876376.0, 2051482776.0,
+	15548960784.0, 56041398784.0, 101180433024.0, 92199790224.0,
+	40788301824.0, 7827719040.0, 479001600.0,
+    /* b_13 */ 1.0, 16356.0, 6699696.0, 507259276.0, 12669817776.0,
+	134323420224.0, 687720046384.0, 1818188642304.0, 2549865473424.0,
+	1883079661824.0, 697929436800.0, 115336085760.0, 6227020800.0,
+    /* b_14 */ 1.0, 32738.0, 20507988.0, 2189829808.0, 75016052228.0,
+	1084676512416.0, 7634832149392.0, 28299910066112.0, 57494373464592.0,
+	64728375139872.0, 39689578055808.0, 12550904017920.0, 1810992556800.0,
+	87178291200.0,
+    /* b_15 */ 1.0, 65504.0, 62407890.0, 9292526920.0, 429826006340.0,
+	8308444327968.0, 78391384831312.0, 394365587815520.0, 1111747472569680.0,
+	1797171220690560.0, 1666424486271456.0, 865023253219584.0,
+	236908271543040.0, 30196376985600.0, 1307674368000.0,
+    /* b_16 */ 1.0, 131038.0, 189123286.0, 38917528600.0, 2400028258540.0,
+	61026142132648.0, 756450802018384.0, 5036317938475648.0,
+	19076135772884080, 42430156603438560, 56071264983487776,
+	43708768764064128, 19515249341231616, 4687098165573120.0,
+	532953524275200.0, 20922789888000.0,
+    /* b_17 */ 1.0, 262108.0, 571432036.0, 161343812980.0,
+	13128749622100.0, 433357644035008.0, 6942861451710184.0,
+	59958264360283168, 2.9759317041784794e+17, 8.8212882458360346e+17,
+	1.5926775166974525e+18, 1.7580730548055007e+18, 1.1715823854813578e+18,
+	4.55924361142656e+17, 97049168010017280, 9927928075161600,
+	355687428096000.0,
+    /* b_18 */ 1.0, 524250.0, 1722945672.0, 663661077072.0,
+	70645406312880.0, 2994008352873048.0, 61167401838986520,
+	6.7406623553015053e+17, 4.297211671488277e+18, 1.655871067670008e+19,
+	3.9572673298262065e+19, 5.9321137058404868e+19, 5.5666251271784161e+19,
+	3.2157753536587055e+19, 1.1030149104146035e+19, 2.0998302094029312e+18,
+	1.946773197057024e+17, 6402373705728000.0,
+    /* b_19 */ 1.0, 1048536.0, 5187185766.0, 2713224461136.0,
+	375127847107776.0, 20224703119250448, 5.2098607181197011e+17,
+	7.2275519394107996e+18, 5.8222825873768858e+19, 2.8590903356867255e+20,
+	8.8238459455178487e+20, 1.740743150455672e+21, 2.2066896929933157e+21,
+	1.7861985800350387e+21, 9.0508056790369278e+20, 2.7626056364165969e+20,
+	4.7405948832458498e+19, 4.008789120817152e+18, 1.21645100408832e+17,
+    /* b_20 */ 1.0, 2097110.0, 15600353130.0, 11039636532120.0,
+	1970602091678640.0, 1.3410256551716707e+17, 4.3143177056190556e+18,
+	7.4491969813269447e+19, 7.4805954298565453e+20, 4.6057751118997912e+21,
+	1.7997592513561139e+22, 4.5595686452918042e+22, 7.5687031071216257e+22,
+	8.2380712138316758e+22, 5.8231173019431361e+22, 2.6142102647955182e+22,
+	7.1598940939099665e+21, 1.1150890784887957e+21, 8.6495828444928e+19,
+	2.43290200817664e+18
+};
+
+/* Sum of the expansion divided by x - a */
+static double gamma_inc_ua_sum(double a, double x, double eps, double *err)
+{
+    const double lambda = x/a;
+    const double r = -a/((x - a) * (x - a));
+    const double *c = gamma_inc_ua_b;
+    double sum = 1.0, abssum = 1.0, rk = 1.0, p, q = 0.0;
+    int j, k;
+
+    for (k = 1; k <= GAMMA_INC_UA_NTERMS; k++)
+    {
+	/* b_k(lambda) and b_k(|lambda|) by Horner's scheme */
+	p = q = c[k - 1];
+	for (j = k - 2; j >= 0; j--)
+	{
+	    p = p * lambda + c[j];
+	    q = q * (-lambda) + c[j];
+	}
+	c += k;
+	rk *= r;
+	sum += rk * lambda * p;
+	abssum += -rk * lambda * q;
+	if (-rk * lambda * q < eps * fabs(sum))
+	    break;
+    }
+
+    /* the bound on the last term for the remainder, and rounding
+     * errors growing with the degree of the polynomials */
+    if (err != NULL)
+	*err = (-rk * lambda * q + 2.0 * (k + 1) * DBL_EPSILON * abssum)/(x - a);
+    return sum/(x - a);
+}
+
+static double gamma_inc_ua(double a, double x, double eps, double *err)
+{
+    const double pre = exp(a * log(x) - x);
+    double serr, res = pre * gamma_inc_ua_sum(a, x, eps, err ? &serr : NULL);
+
+    if (err != NULL)
+	*err = pre * serr +
+	    GAMMA_INC_EXP_ERR(fabs(a * log(x)) + x) * fabs(res);
+    return res;
+}
+
+/* Adapted from specfun/gamma_inc.c in GSL sources. Note that base R
+ * function 'gammafn' and 'pgamma' are used for positive values of
+ * 'a'. The series and continued fractions stop at relative tolerance
+ * 'eps'. The estimate of the absolute error is stored in 'err' unless
+ * it is NULL: the errors of the series, continued fraction and
+ * starting value are propagated through the recursion. */
+static double gamma_inc_impl(double a, double x, double eps, double *err)
+{
+    double res;
+
+    if (isnan(x) || isnan(a))
+    {
+	if (err != NULL) *err = a + x;
+	return a + x;
+    }
+
+    if (x < 0.0)
+    {
+	if (err != NULL) *err = NAN;
+	return(NAN);
+    }
+    else if (x == 0.0)
+    {
+	EXPINT_STATS(expint_stats_count_gamma_inc(EXPINT_STATS_GI_X0));
+	res = gamma_inc_x0(a);
+	if (err != NULL) *err = GAMMA_INC_RMATH_ERR(res);
+	return res;
+    }
+    else if (a == 0.0)
+    {
+	EXPINT_STATS(expint_stats_count_gamma_inc(EXPINT_STATS_GI_A0));
+	return (err == NULL) ? expint_E1(x, 0) : expint_E1_e(x, 0, err);
+    }
+    else if (a > 0.0)
+    {
+	EXPINT_STATS(expint_stats_count_gamma_inc(EXPINT_STATS_GI_PGAMMA));
+	res = gammafn(a) * pgamma(x, a, 1, 0, 0);
+	if (err != NULL) *err = 2.0 * GAMMA_INC_RMATH_ERR(res);
+	return res;
+    }
+    else if (x > 0.25 && a <= -100.0 && x < -100.0 * a)
+    {
+	/* expint: bounded cost for large negative 'a' */
+	EXPINT_STATS(expint_stats_count_gamma_inc(EXPINT_STATS_GI_UA));
+	return gamma_inc_ua(a, x, eps, err);
+    }
+    else if (x > 0.25)
+    {
+	/* continued fraction seems to fail for x too small; otherwise
+	   it is ok, independent of the value of |x/a|, because of the
+	   non-oscillation in the expansion, i.e. the CF is
+	   un-conditionally convergent for a < 0 and x > 0
+	*/
+	const double lpre = (a - 1) * log(x) - x;
+	double Ferr;
+
+	EXPINT_STATS(expint_stats_count_gamma_inc(EXPINT_STATS_GI_CF));
+	res = exp(lpre) * gamma_inc_F_CF_eps(a, x, eps, err ? &Ferr : NULL);
+	if (err != NULL)
+	    *err = exp(lpre) * Ferr +
+		GAMMA_INC_EXP_ERR(fabs((a - 1) * log(x)) + x) * fabs(res);
+	return res;
+    }
+    else if (fabs(a) < 0.5)
+    {
+	/* expint: use the recursion for -0.5 < a < 0 (instead of a
+	 * series expansion as in GSL), relying on the accuracy of
+	 * pgamma for small values of 'a', but nevertheless treat
+	 * this case separately to avoid rounding errors in the loop
+	 * below */
+	const double da = a + 1.0;
+	const double gax = gammafn(da) * pgamma(x, da, 1, 0, 0);
+	const double shift = exp(-x + a * log(x));
+
+	EXPINT_STATS(expint_stats_count_gamma_inc(EXPINT_STATS_GI_SMALL_A));
+	res = (gax - shift)/a;
+	if (err != NULL)
+	    *err = (2.0 * GAMMA_INC_RMATH_ERR(gax) +
+		    GAMMA_INC_EXP_ERR(x + fabs(a * log(x))) * shift)/fabs(a) +
+		DBL_EPSILON * fabs(res);
+	return res;
+    }
+    else if (a < -10.0 && fabs(a - nearbyint(a)) > 1e-7 * fabs(a))
+    {
+	/* expint: constant cost series for large negative 'a' */
+	EXPINT_STATS(expint_stats_count_gamma_inc(EXPINT_STATS_GI_SERIES));
+	return gamma_inc_series(a, x, eps, err);
+    }
+    else
+    {
+	/* a = fa + da; da >= 0 */
+	const double fa = floor(a);
+	const double da = a - fa;
+	const double lx = log(x);
+
+	double gax, gerr = 0.0;
+	double alpha = da;
+	int steps = 0;
+
+	if (da > 0.0)
+	{
+	    gax = gammafn(da) * pgamma(x, da, 1, 0, 0);
+	    gerr = 2.0 * GAMMA_INC_RMATH_ERR(gax);
+	}
+	else
+	    gax = (err == NULL) ? expint_E1(x, 0) : expint_E1_e(x, 0, &gerr);
+
+	/* Gamma(alpha-1,x) = 1/(alpha-1) (Gamma(a,x) - x^(alpha-1) e^-x) */
+	do
+	{
+	    const double lshift = -x + (alpha - 1.0) * lx;
+	    double shift;	/* divided by 1 - alpha > 0 */
+
+	    if (lshift < LOG_DBL_MAX)
+	    {
+		const double s = exp(lshift);
+		gax = (gax - s)/(alpha - 1.0);
+		shift = s/(1.0 - alpha);
+	    }
+	    else
+	    {
+		/* the shift alone overflows, but not the result */
+		shift = exp(lshift - log(1.0 - alpha));
+		gax = gax/(alpha - 1.0) + shift;
+	    }
+	    if (err != NULL)
+		gerr = gerr/(1.0 - alpha) +
+		    GAMMA_INC_EXP_ERR(x + fabs((alpha - 1.0) * lx)) * shift +
+		    2.0 * DBL_EPSILON * fabs(gax);
+	    alpha -= 1.0;
+	    steps++;
+	} while (alpha > a);
+
+	if (EXPINT_STATS_ON)
+	{
+	    expint_stats_count_gamma_inc(EXPINT_STATS_GI_RECURSION);
+	    expint_stats_count_recursion(steps);
+	}
+	if (err != NULL) *err = gerr;
+	return gax;
+  }
+}
+
+/* Value of gamma_inc_impl() taken from the cache, if enabled */
+static double gamma_inc_memo(double a, double x)
+{
+    uint64_t tag = EXPINT_CACHE_TAG_GAMMA_INC(0, 0, expint_prec);
+    unsigned int nsignals = expint_nsignals;
+    double res;
+
+    if (expint_cache_lookup(tag, a, x, &res))
+	return res;
+
+    res = gamma_inc_impl(a, x, EXPINT_EPS(expint_prec), NULL);
+    if (expint_nsignals == nsignals)
+	expint_cache_store(tag, a, x, res);
+    return res;
+}
+
+double gamma_inc(double a, double x)
+{
+    unsigned long long start;
+    double res;
+
+    if (!EXPINT_STATS_ON)
+	return expint_cache_on ? gamma_inc_memo(a, x) :
+	    gamma_inc_impl(a, x, EXPINT_EPS(expint_prec), NULL);
+
+    start = expint_stats_clock();
+    res = expint_cache_on ? gamma_inc_memo(a, x) :
+	gamma_inc_impl(a, x, EXPINT_EPS(expint_prec), NULL);
+    expint_stats_time(EXPINT_STATS_GAMMA_INC, start);
+    return res;
+}
+
+/* Not memoized: the cache holds the values only */
+double gamma_inc_e(double a, double x, double *err)
+{
+    unsigned long long start = EXPINT_STATS_ON ? expint_stats_clock() : 0;
+    double res = gamma_inc_impl(a, x, EXPINT_EPS(expint_prec), err);
+
+    EXPINT_STATS(expint_stats_time(EXPINT_STATS_GAMMA_INC, start));
+    return res;
+}
+
+/* Batch routine of the API. The 'n' values of 'a' are read with
+ * stride 'inca' (0 to recycle a single value) and the 'nx' values of
+ * 'x' are recycled over them; the results are stored contiguously in
+ * 'y'. */
+void gamma_inc_vec(const double *a, ptrdiff_t n, ptrdiff_t inca,
+		   const double *x, ptrdiff_t nx, double *y)
+{
+    ptrdiff_t i, ia, ix;
+
+    for (i = ia = ix = 0; i < n; i++, ia += inca)
+    {
+	y[i] = gamma_inc(a[ia], x[ix]);
+	if (++ix == nx) ix = 0;
+    }
+}
+
+/*
+ *  SCALED FUNCTION AND LOGARITHM
+ *
+ *  The scaled function e^x x^(1-a) G(a,x) and log G(a,x) remain
+ *  representable far beyond the range of G(a,x). Each branch of
+ *  gamma_inc_impl() is recast to give G(a,x) = m e^e with a factor
+ *  'm' of moderate size, along with the exponent 'es' such that the
+ *  scaled function is m e^es. The exponents are obtained
+ *  analytically: in particular, 'es' is 0 for the continued fraction,
+ *  so that neither the prefactor x^(a-1) e^{-x} nor its inverse are
+ *  ever computed.
+ */
+
+/* Factor 'm' of G(a,x) for x > 0, with the exponents stored in 'e'
+ * and 'es', and the estimate of the absolute error of 'm' in 'err'
+ * unless it is NULL */
+static double gamma_inc_split(double a, double x, double eps,
+			      double *e, double *es, double *err)
+{
+    const double lx = log(x);
+
+    if (a == 0.0)
+    {
+	EXPINT_STATS(expint_stats_count_gamma_inc(EXPINT_STATS_GI_A0));
+	*e = -x;
+	*es = lx;
+	return (err == NULL) ? expint_E1(x, 1) : expint_E1_e(x, 1, err);
+    }
+    else if (a > 0.0 && (x <= 0.25 || x <= a + 1.0))
+    {
+	/* G(a,x) = gammafn(a) Q(a,x) and the scaled function is Q(a,x)
+	 * over the density of the gamma distribution, both on the log
+	 * scale */
+	const double lq = pgamma(x, a, 1, 0, 1);
+	EXPINT_STATS(expint_stats_count_gamma_inc(EXPINT_STATS_GI_PGAMMA));
+	*e = lgammafn(a) + lq;
+	*es = lq - dgamma(x, a, 1, 1);
+	if (err != NULL) *err = 2.0 * GAMMA_INC_RMATH_ERR(1.0);
+	return 1.0;
+    }
+    else if (x > 0.25 && a <= -100.0 && x < -100.0 * a)
+    {
+	EXPINT_STATS(expint_stats_count_gamma_inc(EXPINT_STATS_GI_UA));
+	*e = a * lx - x;
+	*es = lx;
+	return gamma_inc_ua_sum(a, x, eps, err);
+    }
+    else if (x > 0.25)
+    {
+	/* continued fraction, also for a > 0 and x > a + 1 */
+	EXPINT_STATS(expint_stats_count_gamma_inc(EXPINT_STATS_GI_CF));
+	*e = (a - 1.0) * lx - x;
+	*es = 0.0;
+	return gamma_inc_F_CF_eps(a, x, eps, err);
+    }
+    else if (fabs(a) < 0.5)
+    {
+	/* G(a,x) itself is of moderate size */
+	*e = 0.0;
+	*es = x + (1.0 - a) * lx;
+	return gamma_inc_impl(a, x, eps, err);
+    }
+    else if (a < -10.0 && fabs(a - nearbyint(a)) > 1e-7 * fabs(a))
+    {
+	/* G(a,x) = x^a (G(a) x^-a - sum) */
+	const double g = (a > -170.0 ? gamma_neg(a) * exp(-a * lx) : 0.0);
+	double serr, m;
+
+	EXPINT_STATS(expint_stats_count_gamma_inc(EXPINT_STATS_GI_SERIES));
+	*e = a * lx;
+	*es = x + lx;
+	m = g - gamma_inc_series_sum(a, x, eps, err ? &serr : NULL);
+	if (err != NULL)
+	    *err = (GAMMA_INC_RMATH_ERR(1.0) + GAMMA_INC_EXP_ERR(fabs(a * lx))) *
+		fabs(g) + serr + DBL_EPSILON * fabs(m);
+	return m;
+    }
+    else
+    {
+	/* recursion of gamma_inc_impl() on the scaled function
+	 * S(alpha,x) = e^x x^(1-alpha) G(alpha,x):
+	 *
+	 *   S(alpha-1,x) = x (S(alpha,x) - 1)/(alpha-1) */
+	const double fa = floor(a);
+	const double da = a - fa;
+
+	double s, serr = 0.0;
+	double alpha = da;
+	int steps = 0;
+
+	if (da > 0.0)
+	{
+	    s = gammafn(da) * pgamma(x, da, 1, 0, 0) *
+		exp(x + (1.0 - da) * lx);
+	    serr = (2.0 * GAMMA_INC_RMATH_ERR(1.0) +
+		    GAMMA_INC_EXP_ERR(x + fabs((1.0 - da) * lx))) * fabs(s);
+	}
+	else if (err == NULL)
+	    s = x * expint_E1(x, 1);
+	else
+	{
+	    s = x * expint_E1_e(x, 1, &serr);
+	    serr = x * serr + DBL_EPSILON * fabs(s);
+	}
+
+	do
+	{
+	    if (err != NULL)
+		serr = x * (serr + DBL_EPSILON * fabs(s - 1.0))/fabs(alpha - 1.0);
+	    s = x * (s - 1.0)/(alpha - 1.0);
+	    if (err != NULL)
+		serr += 2.0 * DBL_EPSILON * fabs(s);
+	    alpha -= 1.0;
+	    steps++;
+	} while (alpha > a);
+
+	if (EXPINT_STATS_ON)
+	{
+	    expint_stats_count_gamma_inc(EXPINT_STATS_GI_RECURSION);
+	    expint_stats_count_recursion(steps);
+	}
+	*e = (a - 1.0) * lx - x;
+	*es = 0.0;
+	if (err != NULL) *err = serr;
+	return s;
+    }
+}
+
+/* The estimate of the absolute error stored in 'err' unless it is
+ * NULL combines the error of the factor 'm' with a bound on the
+ * rounding errors of the exponent, whose terms are at most about
+ * |a log(x)|, |log(x)| and x in absolute value. */
+static double gamma_inc_ls_impl(double a, double x, int scale,
+				int give_log, double eps, double *err)
+{
+    double m, merr, e, es, eerr, res;
+
+    if (isnan(x) || isnan(a))
+    {
+	if (err != NULL) *err = a + x;
+	return a + x;
+    }
+
+    if (x < 0.0)
+    {
+	if (err != NULL) *err = NAN;
+	return NAN;
+    }
+    else if (x == 0.0)
+    {
+	EXPINT_STATS(expint_stats_count_gamma_inc(EXPINT_STATS_GI_X0));
+	if (!scale)
+	{
+	    res = (a > 0.0) ? lgammafn(a) : log(gamma_inc_x0(a));
+	    if (err != NULL) *err = GAMMA_INC_RMATH_ERR(res) + DBL_EPSILON;
+	    return res;
+	}
+	/* limit of the scaled function as x -> 0+ */
+	m = (a < 1.0) ? 0.0 : (a == 1.0) ? 1.0 : INFINITY;
+	if (err != NULL) *err = 0.0;
+	return give_log ? log(m) : m;
+    }
+
+    m = gamma_inc_split(a, x, eps, &e, &es, err ? &merr : NULL);
+    if (scale)
+	e = es;
+    res = give_log ? e + log(m) : m * exp(e);
+    if (err != NULL)
+    {
+	eerr = GAMMA_INC_EXP_ERR(fabs(a * log(x)) + fabs(log(x)) + x + fabs(e));
+	*err = give_log ? merr/fabs(m) + eerr + DBL_EPSILON * fabs(res) :
+	    merr * exp(e) + (eerr + DBL_EPSILON) * fabs(res);
+    }
+    return res;
+}
+
+/* Value of gamma_inc_ls_impl() taken from the cache, if enabled */
+static double gamma_inc_ls_memo(double a, double x, int scale, int give_log)
+{
+    uint64_t tag = EXPINT_CACHE_TAG_GAMMA_INC(scale, give_log, expint_prec);
+    unsigned int nsignals = expint_nsignals;
+    double res;
+
+    if (expint_cache_lookup(tag, a, x, &res))
+	return res;
+
+    res = gamma_inc_ls_impl(a, x, scale, give_log, EXPINT_EPS(expint_prec),
+			    NULL);
+    if (expint_nsignals == nsignals)
+	expint_cache_store(tag, a, x, res);
+    return res;
+}
+
+static double gamma_inc_ls(double a, double x, int scale, int give_log)
+{
+    unsigned long long start = EXPINT_STATS_ON ? expint_stats_clock() : 0;
+    double res;
+
+    res = expint_cache_on ? gamma_inc_ls_memo(a, x, scale, give_log) :
+	gamma_inc_ls_impl(a, x, scale, give_log, EXPINT_EPS(expint_prec), NULL);
+    EXPINT_STATS(expint_stats_time(EXPINT_STATS_GAMMA_INC_LOG, start));
+    return res;
+}
+
+double gamma_inc_scaled(double a, double x)
+{
+    return gamma_inc_ls(a, x, 1, 0);
+}
+
+double gamma_inc_log(double a, double x, int scale)
+{
+    return gamma_inc_ls(a, x, scale != 0, 1);
+}
+
+/* Not memoized: the cache holds the values only */
+static double gamma_inc_ls_e(double a, double x, int scale, int give_log,
+			     double *err)
+{
+    unsigned long long start = EXPINT_STATS_ON ? expint_stats_clock() : 0;
+    double res;
+
+    res = gamma_inc_ls_impl(a, x, scale, give_log, EXPINT_EPS(expint_prec), err);
+    EXPINT_STATS(expint_stats_time(EXPINT_STATS_GAMMA_INC_LOG, start));
+    return res;
+}
+
+double gamma_inc_scaled_e(double a, double x, double *err)
+{
+    return gamma_inc_ls_e(a, x, 1, 0, err);
+}
+
+double gamma_inc_log_e(double a, double x, int scale, double *err)
+{
+    return gamma_inc_ls_e(a, x, scale != 0, 1, err);
+}
+
+/* Incomplete gamma functions G(a - k, x) for k = 0, ..., K, stored in
+ * 'y' with stride 'incy'.
+ *
+ * For x > 0, one value is computed with gamma_inc() at s = a - k0,
+ * where k0 is chosen such that s is near -x, and the others follow
+ * from the recurrence relation
+ *
+ *   G(s + 1, x) = s G(s, x) + x^s e^{-x}
+ *
+ * used downward (k > k0) for s < -x and upward (k < k0) for s > -x,
+ * the directions in which there is no cancellation. For x <= 0.25,
+ * this is the same traversal as in gamma_inc(), without throwing
+ * away the intermediate values. */
+static void gamma_inc_ladder_impl(double a, double x, int K,
+				  double *y, ptrdiff_t incy)
+{
+    int k, k0;
+    double g, s, lx;
+
+    if (K < 0)
+	return;
+
+    if (isnan(a) || isnan(x) || x <= 0.0)
+    {
+	for (k = 0; k <= K; k++)
+	    y[k * incy] = gamma_inc(a - k, x);
+	return;
+    }
+
+    s = floor(a + x + 0.5);
+    k0 = (s < 0.0) ? 0 : (s > K) ? K : (int) s;
+    lx = log(x);
+
+    g = gamma_inc(a - k0, x);
+    y[k0 * incy] = g;
+
+    /* downward: G(s - 1, x) = (G(s, x) - x^(s-1) e^-x)/(s - 1) */
+    for (k = k0 + 1, s = a - k0; k <= K; k++)
+    {
+	s -= 1.0;
+	g = (g - exp(s * lx - x))/s;
+	y[k * incy] = g;
+    }
+
+    /* upward: G(s + 1, x) = s G(s, x) + x^s e^-x */
+    g = y[k0 * incy];
+    for (k = k0 - 1, s = a - k0; k >= 0; k--)
+    {
+	g = s * g + exp(s * lx - x);
+	s += 1.0;
+	y[k * incy] = g;
+    }
+}
+
+void gamma_inc_ladder(double a, double x, int K, double *y, ptrdiff_t incy)
+{
+    unsigned long long start = EXPINT_STATS_ON ? expint_stats_clock() : 0;
+
+    gamma_inc_ladder_impl(a, x, K, y, incy);
+    EXPINT_STATS(expint_stats_time(EXPINT_STATS_GAMMA_INC_LADDER, start));
+}
+
+/*
+ *  DERIVATIVES
+ *
+ *  The partial derivatives of G(a,x) are
+ *
+ *    dG/dx = -x^(a-1) e^{-x},
+ *    dG/da = int_x^infty t^{a-1} log(t) e^{-t} dt.
+ *
+ *  The latter is obtained by differentiating in 'a' the expansions
+ *  used for G(a,x) itself, alongside them.
+ */
+
+/* Continued fraction F(a,x) of gamma_inc_F_CF_eps() and, in 'dF', its
+ * derivative with respect to 'a', obtained by differentiating the
+ * recurrences of the modified Lentz algorithm. The iterations stop
+ * when both have converged. */
+static double gamma_inc_F_CF_deriv(double a, double x, double eps,
+				   double *dF)
+{
+    const int    nmax  =  5000;
+    const double small =  R_pow_di(DBL_EPSILON, 3);
+
+    double hn = 1.0, dlh = 0.0; /* convergent and d/da log(hn) */
+    double Cn = 1.0 / small, dCn = 0.0;
+    double Dn = 1.0, dDn = 0.0;
+    int n;
+
+    for (n = 2 ; n < nmax ; n++)
+    {
+	double an, dan, t, delta, ddelta;
+
+	if (E1_IS_ODD(n))
+	{
+	    an = 0.5 * (n - 1)/x;
+	    dan = 0.0;
+	}
+	else
+	{
+	    an = (0.5 * n - a)/x;
+	    dan = -1.0/x;
+	}
+
+	/* D_n = 1/(1 + a_n D_{n-1}), C_n = 1 + a_n/C_{n-1} */
+	t = 1.0 + an * Dn;
+	if (fabs(t) < small)
+	{
+	    t = small;
+	    dDn = 0.0;
+	}
+	else
+	    dDn = -(dan * Dn + an * dDn)/(t * t);
+	Dn = 1.0/t;
+	t = 1.0 + an/Cn;
+	if (fabs(t) < small)
+	{
+	    t = small;
+	    dCn = 0.0;
+	}
+	else
+	    dCn = (dan - an * dCn/Cn)/Cn;
+	Cn = t;
+	delta = Cn * Dn;
+	ddelta = dCn/Cn + dDn/Dn;
+	hn *= delta;
+	dlh += ddelta;
+	if (fabs(delta - 1.0) < eps && fabs(ddelta) <= eps * fabs(dlh))
+	    break;
+    }
+
+    EXPINT_STATS(expint_stats_count_cf(n));
+    if (n == nmax)
+	expint_signal(EXPINT_CF_MAXITER);
+
+    *dF = hn * dlh;
+    return hn;
+}
+
+/* Coefficients of the Taylor series of Gamma(1 + a) - 1 at a = 0 */
+static const double gamma1pm1_taylor[] = {
+    -0.57721566490153286061, 0.98905599532797255540,
+    -0.90747907608088628902, 0.98172808683440018734,
+    -0.98199506890314520210, 0.99314911462127619315,
+    -0.99600176044243153397, 0.99810569378312892198,
+    -0.99902526762195486779, 0.99951565607277744107,
+    -0.99975659750860128703, 0.99987827131513327573
+};
+
+/* (Gamma(1 + a) - 1)/a and its derivative in 'd', by the Taylor
+ * series for |a| < 0.02, where the direct formulas cancel */
+static double gamma1pm1_a(double a, double *d)
+{
+    const int n = sizeof(gamma1pm1_taylor)/sizeof(double);
+    double v, phi;
+    int k;
+
+    if (fabs(a) < 0.02)
+    {
+	v = gamma1pm1_taylor[n - 1];
+	*d = 0.0;
+	for (k = n - 2; k >= 0; k--)
+	{
+	    *d = *d * a + v;
+	    v = v * a + gamma1pm1_taylor[k];
+	}
+	return v;
+    }
+
+    phi = expm1(lgamma1p(a));
+    v = phi/a;
+    *d = ((phi + 1.0) * digamma(1.0 + a) - v)/a;
+    return v;
+}
+
+/* (e^u - 1)/u and its derivative in 'd', by the Taylor series for
+ * |u| < 0.5 */
+static double expm1_u(double u, double *d)
+{
+    double v, term;
+    int k;
+
+    if (fabs(u) >= 0.5)
+    {
+	v = expm1(u)/u;
+	*d = (exp(u) - v)/u;
+	return v;
+    }
+
+    /* sum of u^k/(k+1)! and of k u^(k-1)/(k+1)! */
+    v = 1.0;
+    *d = 0.0;
+    term = 1.0;
+    for (k = 1; k < 30; k++)
+    {
+	*d += k * term/(k + 1);
+	term *= u/(k + 1);
+	v += term;
+	if (fabs(term) < DBL_EPSILON * fabs(v))
+	    break;
+    }
+    return v;
+}
+
+/* Series for |a| < 0.5 and small 'x':
+ *
+ *   G(a,x) = h(a) - x^a sum_{k=1}^infty (-x)^k/(k! (a+k)),
+ *
+ * where h(a) = Gamma(a) - x^a/a = ((Gamma(1+a) - 1) - (x^a - 1))/a
+ * remains accurate as 'a' tends to 0; it is E_1(x) + O(a) at the
+ * limit. The derivative in 'a' is returned in 'da'. */
+static double gamma_inc_small_a_deriv(double a, double x, double eps,
+				      double *da)
+{
+    const int nmax = 200;
+    const double lx = log(x);
+    double h, dh, e, de, xa, s1 = 0.0, s2 = 0.0, term = 1.0, t;
+    int k;
+
+    h = gamma1pm1_a(a, &dh);
+    e = expm1_u(a * lx, &de);
+    h -= lx * e;
+    dh -= lx * lx * de;
+
+    for (k = 1; k < nmax; k++)
+    {
+	term *= -x/k;
+	t = term/(a + k);
+	s1 += t;
+	s2 += t/(a + k);
+	if (fabs(t) < eps * fabs(s1))
+	    break;
+    }
+
+    xa = exp(a * lx);
+    *da = dh - lx * xa * s1 + xa * s2;
+    return h - xa * s1;
+}
+
+/* Series for a >= 0.5 and x <= a + 1: G(a,x) = Gamma(a) - g(a,x) with
+ * the lower incomplete gamma function
+ *
+ *   g(a,x) = x^a e^{-x} sum_{k=0}^infty x^k/(a (a+1) ... (a+k)),
+ *
+ * whose terms are positive. The value itself is computed as in
+ * gamma_inc_impl(), and the derivative in 'a' is returned in 'da'. */
+static double gamma_inc_pos_deriv(double a, double x, double eps,
+				  double *da)
+{
+    const int nmax = 10000;
+    double ga = gammafn(a), t, s, sum, dsum, f;
+    int k;
+
+    if (!isfinite(ga))
+    {
+	*da = ga;
+	return ga;
+    }
+
+    /* terms and their derivatives -t_k (1/a + ... + 1/(a+k)) */
+    t = sum = 1.0/a;
+    s = 1.0/a;
+    dsum = -t * s;
+    for (k = 1; k < nmax; k++)
+    {
+	t *= x/(a + k);
+	s += 1.0/(a + k);
+	sum += t;
+	dsum -= t * s;
+	if (t < eps * sum && t * s < eps * fabs(dsum))
+	    break;
+    }
+
+    f = exp(a * log(x) - x);
+    *da = ga * digamma(a) - f * (log(x) * sum + dsum);
+    return ga * pgamma(x, a, 1, 0, 0);
+}
+
+/* Series of gamma_inc_series() for large negative non-integer 'a'
+ * and small 'x', with the derivative in 'a' returned in 'da':
+ *
+ *   dG/da = Gamma(a) psi(a) - x^a (log(x) S + dS/da),
+ *
+ * where S is the sum of the series, whose terms differentiate to
+ * -(-x)^k/(k! (a+k)^2). The cost is independent of |a|. */
+static double gamma_inc_series_deriv(double a, double x, double eps,
+				     double *da)
+{
+    const int nmax = 200;
+    const double m = -nearbyint(a), lx = log(x);
+    double sum = 1.0/a, dsum = -1.0/(a * a), term = 1.0, t, g, d, res;
+    int k;
+
+    for (k = 1; k < nmax; k++)
+    {
+	term *= -x/k;
+	t = term/(a + k);
+	sum += t;
+	dsum -= t/(a + k);
+	if (fabs(t) < eps * fabs(sum) && fabs(t/(a + k)) < eps * fabs(dsum))
+	    break;
+    }
+
+    /* the term of order k = -a, as in gamma_inc_series_sum() */
+    if (k < m && (fabs(term) > eps * fabs(sum) * fabs(a + m) ||
+		  fabs(term) > eps * fabs(dsum) * (a + m) * (a + m)))
+    {
+	t = exp(m * lx - lgammafn(m + 1.0))/(a + m);
+	if (fmod(m, 2.0) != 0.0)
+	    t = -t;
+	sum += t;
+	dsum -= t/(a + m);
+    }
+
+    /* x^a S and x^a (log(x) S + dS/da) on the log scale */
+    g = (a > -170.0) ? gamma_neg(a) : 0.0;
+    t = exp(a * lx + log(fabs(sum)));
+    res = g - ((sum < 0.0) ? -t : t);
+    d = lx * sum + dsum;
+    t = exp(a * lx + log(fabs(d)));
+    *da = ((g != 0.0) ? g * digamma(a) : 0.0) - ((d < 0.0) ? -t : t);
+    return res;
+}
+
+/* Incomplete gamma function G(a,x) and its partial derivatives with
+ * respect to 'x' and 'a', stored in 'y' with stride 'incy'.
+ *
+ * The continued fraction is used for x > 0.25 when a <= 0 or x > a +
+ * 1; otherwise, the series above, the series for large negative 'a'
+ * on the same terms as gamma_inc_impl(), or, for the other a <= -0.5,
+ * one of the first two followed by the recursion in 'a' of
+ * gamma_inc_impl() and its derivative
+ *
+ *   dG(s-1,x) = (dG(s,x) - log(x) x^(s-1) e^{-x} - G(s-1,x))/(s-1).
+ *
+ * Values agree with gamma_inc() up to rounding. The uniform
+ * asymptotic expansion for large negative 'a' is not differentiated;
+ * the continued fraction is used instead. */
+static void gamma_inc_deriv_impl(double a, double x, double *y,
+				 ptrdiff_t incy)
+{
+    const double eps = EXPINT_EPS(expint_prec);
+    double g, dx, da, lx;
+
+    if (isnan(x) || isnan(a))
+    {
+	y[0] = y[incy] = y[2 * incy] = a + x;
+	return;
+    }
+    if (x < 0.0)
+    {
+	y[0] = y[incy] = y[2 * incy] = NAN;
+	return;
+    }
+    if (x == 0.0)
+    {
+	g = gamma_inc(a, x);
+	y[0] = g;
+	y[incy] = -R_pow(x, a - 1.0);
+	y[2 * incy] = g * digamma(a);
+	return;
+    }
+
+    lx = log(x);
+    dx = -exp((a - 1.0) * lx - x);
+
+    if (x > 0.25 && (a <= 0.0 || x > a + 1.0))
+    {
+	double F, dF;
+	F = gamma_inc_F_CF_deriv(a, x, eps, &dF);
+	g = -dx * F;
+	da = lx * g - dx * dF;
+    }
+    else if (a >= 0.5)
+	g = gamma_inc_pos_deriv(a, x, eps, &da);
+    else if (a > -0.5)
+	g = gamma_inc_small_a_deriv(a, x, eps, &da);
+    else if (a < -10.0 && fabs(a - nearbyint(a)) > 1e-7 * fabs(a))
+	g = gamma_inc_series_deriv(a, x, eps, &da);
+    else
+    {
+	/* a = fa + r; 0 <= r < 1 */
+	const double fa = floor(a);
+	double s = a - fa, shift;
+
+	g = (s >= 0.5) ? gamma_inc_pos_deriv(s, x, eps, &da) :
+	    gamma_inc_small_a_deriv(s, x, eps, &da);
+	do
+	{
+	    shift = exp(-x + (s - 1.0) * lx);
+	    g = (g - shift)/(s - 1.0);
+	    da = (da - lx * shift - g)/(s - 1.0);
+	    s -= 1.0;
+	} while (s > a);
+    }
+
+    y[0] = g;
+    y[incy] = dx;
+    y[2 * incy] = da;
+}
+
+void gamma_inc_deriv(double a, double x, double *y, ptrdiff_t incy)
+{
+    unsigned long long start = EXPINT_STATS_ON ? expint_stats_clock() : 0;
+
+    gamma_inc_deriv_impl(a, x, y, incy);
+    EXPINT_STATS(expint_stats_time(EXPINT_STATS_GAMMA_INC_DERIV, start));
+}
+
+/*
+ *  INVERSE
+ *
+ *  Solution in x of G(a,x) = y with the solver of expint.c. With
+ *  G(a,x) = m e^e and the scaled function S(a,x) = e^x x^(1-a) G(a,x)
+ *  = m e^es as given by gamma_inc_split(), the logarithm of G(a,x)/y
+ *  and its derivatives are
+ *
+ *    e + log(m) - log(y),
+ *    -1/S(a,x),
+ *    (1 + (1-a)/x)/S(a,x) - 1/S(a,x)^2.
+ */
+typedef struct {
+    double a;
+    double ly;			/* log(y) */
+} gamma_inc_inv_par;
+
+static double gamma_inc_logfun(double x, const void *par,
+			       double *d1, double *d2)
+{
+    const gamma_inc_inv_par *p = par;
+    double m, e, es, r;
+
+    m = gamma_inc_split(p->a, x, EXPINT_EPS(expint_prec), &e, &es, NULL);
+    r = exp(-es - log(m));
+    *d1 = -r;
+    *d2 = r * (1.0 + (1.0 - p->a)/x) - r * r;
+    return e + log(m) - p->ly;
+}
+
+/* Initial values: for a > 0, the quantile of the gamma distribution
+ * (for which G(a,x) = gammafn(a) Q(a,x)), then polished; for a <= 0,
+ * G(a,x) ~ x^a e^{-x}/(x - a) [leading term of the uniform expansion]
+ * for large x and, for small x, G(a,x) ~ gammafn(a) - x^a/a (a < 0,
+ * the first term dropped for integer or large negative 'a') or
+ * -gamma - log(x) (a = 0). The threshold between the two is about
+ * G(a,1). */
+static double gamma_inc_inv_impl(double a, double y)
+{
+    gamma_inc_inv_par par;
+    double t, x0;
+
+    if (isnan(a) || isnan(y))
+	return a + y;
+
+    if (y < 0.0)
+	return NAN;
+    if (y == 0.0)
+	return INFINITY;
+
+    par.a = a;
+    par.ly = log(y);
+    if (a > 0.0)
+    {
+	/* compare with Gamma(a) itself where it is representable, so
+	 * that y = gamma(a) gives exactly 0 */
+	t = (a < 170.0) ? log(y / gammafn(a)) : par.ly - lgammafn(a);
+	if (t >= 0.0)
+	    return (t == 0.0) ? 0.0 : NAN;
+	x0 = qgamma(t, a, 1, 0, 1);
+    }
+    else
+    {
+	if (y == INFINITY)
+	    return 0.0;
+	t = -par.ly;
+	if (y < exp(-1.0)/(1.0 - a))
+	    x0 = t + a * log(t) - log(t - a);
+	else if (a < 0.0)
+	{
+	    t = (a > -170.0 && a != floor(a)) ? a * (gamma_neg(a) - y) : 0.0;
+	    x0 = exp(log(t > 0.0 ? t : -a * y)/a);
+	}
+	else
+	    x0 = exp(-EULER_CNST - y);
+    }
+    if (!(x0 > DBL_MIN && x0 < DBL_MAX))
+	x0 = 1.0;
+
+    return expint_solve(gamma_inc_logfun, &par, x0);
+}
+
+double gamma_inc_inv(double a, double y)
+{
+    unsigned long long start = EXPINT_STATS_ON ? expint_stats_clock() : 0;
+    double res = gamma_inc_inv_impl(a, y);
+
+    EXPINT_STATS(expint_stats_time(EXPINT_STATS_GAMMA_INC_INV, start));
+    return res;
+}
@@ -0,0 +1,241 @@
+/*  == expint: Exponential Integral and Incomplete Gamma Function ==
+ *
+ *  Public header of libexpint, the core of package expint that does
+ *  not depend on R. The library only requires the standalone R math
+ *  library (libRmath) for the gamma function and distribution.
+ *
+ *  AUTHOR: Vincent Goulet <vincent.goulet@act.ulaval.ca>
+ */
+
+#ifndef LIBEXPINT_H
+#define LIBEXPINT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Scalar functions */
+double expint_E1(double x, int scale);
+double expint_E2(double x, int scale);
+double expint_En(double x, int order, int scale);
+double gamma_inc(double a, double x);
+double gamma_inc_F_CF(double a, double x);
+
+/* Incomplete gamma function scaled by e^x x^(1-a), and logarithm of
+ * G(a,x) (of the scaled function when 'scale' is non zero), without
+ * overflow or underflow in the intermediate computations */
+double gamma_inc_scaled(double a, double x);
+double gamma_inc_log(double a, double x, int scale);
+
+/* Same functions, returning along with the value an estimate of its
+ * absolute error in 'err', as the GSL functions returning a
+ * 'gsl_sf_result'. The values are those of the functions above. */
+double expint_E1_e(double x, int scale, double *err);
+double expint_E2_e(double x, int scale, double *err);
+double expint_En_e(double x, int order, int scale, double *err);
+double gamma_inc_e(double a, double x, double *err);
+double gamma_inc_scaled_e(double a, double x, double *err);
+double gamma_inc_log_e(double a, double x, int scale, double *err);
+
+/* Batch routines: contiguous input and output of length 'n'. The
+ * SIMD kernel is selected on first use, or by a call to
+ * expint_batch_init(). */
+void expint_batch_init(void);
+void expint_E1_batch(const double *x, double *y, ptrdiff_t n, int scale);
+void expint_E2_batch(const double *x, double *y, ptrdiff_t n, int scale);
+
+/* Vectorized functions: 'n' values taken from 'x' with stride 'incx';
+ * shorter arguments are recycled. */
+void expint_E1_vec(const double *x, ptrdiff_t n, ptrdiff_t incx,
+		   int scale, double *y);
+void expint_E2_vec(const double *x, ptrdiff_t n, ptrdiff_t incx,
+		   int scale, double *y);
+void expint_En_vec(const double *x, ptrdiff_t n, ptrdiff_t incx,
+		   const int *order, ptrdiff_t norder, int scale, double *y);
+void gamma_inc_vec(const double *a, ptrdiff_t n, ptrdiff_t inca,
+		   const double *x, ptrdiff_t nx, double *y);
+
+/* Exponential integrals of orders 1, ..., 'nmax' at 'x', stored in
+ * 'y' with stride 'incy' */
+void expint_En_seq(double x, int nmax, int scale, double *y, ptrdiff_t incy);
+
+/* Incomplete gamma functions G(a - k, x) for k = 0, ..., K, stored
+ * in 'y' with stride 'incy' */
+void gamma_inc_ladder(double a, double x, int K, double *y, ptrdiff_t incy);
+
+/* Derivatives: E_n(x) and its derivatives of orders 1, ..., 'nderiv'
+ * with respect to 'x'; G(a,x) and its partial derivatives with
+ * respect to 'x' and 'a'. Values stored in 'y' with stride 'incy'. */
+void expint_En_deriv(double x, int n, int nderiv, int scale,
+		     double *y, ptrdiff_t incy);
+void gamma_inc_deriv(double a, double x, double *y, ptrdiff_t incy);
+
+/* Inverses: the solutions 'x' of E_n(x) = y and G(a,x) = y, NaN when
+ * 'y' is out of the range of the function */
+double expint_En_inv(double y, int n);
+double gamma_inc_inv(double a, double y);
+
+/* Interpolation tables: piecewise Chebyshev expansions of a function
+ * of 'x' over [lower, upper] with relative error at most 'tol'. The
+ * function is one of EXPINT_TABLE_* with parameter 'param' (the order
+ * for E_n, 'a' for the incomplete gamma function). Evaluation outside
+ * of [lower, upper] falls back to the exact routine. A table saved to
+ * a file is memory-mapped when loaded, so that processes loading the
+ * same file share a single read-only copy. expint_table_build() and
+ * expint_table_load() return NULL on failure. */
+enum {
+    EXPINT_TABLE_E1,
+    EXPINT_TABLE_E2,
+    EXPINT_TABLE_EN,
+    EXPINT_TABLE_GAMMA_INC
+};
+typedef struct expint_table expint_table;
+expint_table *expint_table_build(int fun, double param,
+				 double lower, double upper, double tol);
+double expint_table_eval(const expint_table *table, double x);
+void expint_table_eval_vec(const expint_table *table, const double *x,
+			   ptrdiff_t n, double *y);
+int expint_table_save(const expint_table *table, const char *file);
+expint_table *expint_table_load(const char *file);
+void expint_table_free(expint_table *table);
+void expint_table_info(const expint_table *table, int *fun, double *param,
+		       double *lower, double *upper, double *tol,
+		       ptrdiff_t *npieces, int *mapped);
+
+/* Streaming evaluation over binary files of doubles in the native
+ * byte order: the values of 'infile' are passed by windows of at most
+ * a few megabytes to 'f', along with the corresponding window of
+ * 'outfile' (created or resized to the size of 'infile'; the values
+ * are replaced in place when both are the same file) and 'data'. The
+ * evaluation stops when 'f' returns non zero. Returns one of
+ * EXPINT_STREAM_* and the number of values written in 'count'. */
+enum {
+    EXPINT_STREAM_OK,
+    EXPINT_STREAM_EINPUT,	/* cannot read or map the input */
+    EXPINT_STREAM_EOUTPUT,	/* cannot write or map the output */
+    EXPINT_STREAM_STOPPED	/* stopped by 'f' */
+};
+typedef int (*expint_stream_fun)(const double *x, double *y, ptrdiff_t n,
+				 void *data);
+int expint_stream(const char *infile, const char *outfile,
+		  expint_stream_fun f, void *data, int64_t *count);
+
+/* Precision of the computations of the calling thread: full double
+ * precision (the default) or about single precision, in which case
+ * the Chebyshev expansions are truncated at their single precision
+ * order and the iterative methods stop at a relative tolerance of
+ * FLT_EPSILON. Returns the previous precision. */
+#define EXPINT_PREC_DOUBLE 0
+#define EXPINT_PREC_SINGLE 1
+int expint_set_precision(int precision);
+
+/* Conditions met by the workhorses */
+enum {
+    EXPINT_E1_OVERFLOW,
+    EXPINT_E1_UNDERFLOW,
+    EXPINT_E2_OVERFLOW,
+    EXPINT_E2_UNDERFLOW,
+    EXPINT_EN_UNDERFLOW,
+    EXPINT_CF_MAXITER,
+    EXPINT_NCONDITIONS
+};
+
+/* Kinds of conditions in the status of an element (bit flags) */
+#define EXPINT_STATUS_OVERFLOW  1
+#define EXPINT_STATUS_UNDERFLOW 2
+#define EXPINT_STATUS_MAXITER   4
+
+/* Conditions met by the calling thread: kinds since the last call to
+ * expint_take_status() and number of each condition since the last
+ * call to expint_take_counts() (array of EXPINT_NCONDITIONS values).
+ * The optional handler is called each time a condition is met. */
+int expint_take_status(void);
+void expint_take_counts(size_t *counts);
+void expint_set_signal_handler(void (*handler)(int));
+
+/* Instrumentation (opt-in at run time; compiled out altogether when
+ * EXPINT_NO_STATS is defined). Counts per region of expint_E1()
+ * (intervals of the Chebyshev expansions; 'other' is for NaN, 0,
+ * overflow and underflow) and per branch of gamma_inc(); histograms
+ * of the iterations of the continued fraction and of the steps of
+ * the recursion in 'a', by powers of two; calls and cumulative time
+ * in nanoseconds per entry point, inclusive of the calls made
+ * internally. */
+enum {
+    EXPINT_STATS_E1_AE11,	/* x <= -10      */
+    EXPINT_STATS_E1_AE12,	/* -10 < x <= -4 */
+    EXPINT_STATS_E1_E11,	/* -4 < x <= -1  */
+    EXPINT_STATS_E1_E12,	/* -1 < x <= 1   */
+    EXPINT_STATS_E1_AE13,	/* 1 < x <= 4    */
+    EXPINT_STATS_E1_AE14,	/* x > 4         */
+    EXPINT_STATS_E1_OTHER,
+    EXPINT_STATS_E1_NREGIONS
+};
+
+enum {
+    EXPINT_STATS_GI_X0,		/* x = 0                       */
+    EXPINT_STATS_GI_A0,		/* a = 0                       */
+    EXPINT_STATS_GI_PGAMMA,	/* a > 0                       */
+    EXPINT_STATS_GI_UA,		/* uniform asymptotic expansion */
+    EXPINT_STATS_GI_CF,		/* continued fraction          */
+    EXPINT_STATS_GI_SMALL_A,	/* -0.5 < a < 0                */
+    EXPINT_STATS_GI_SERIES,	/* series for a < -10          */
+    EXPINT_STATS_GI_RECURSION,	/* recursion in 'a'            */
+    EXPINT_STATS_GI_NBRANCHES
+};
+
+enum {
+    EXPINT_STATS_E1,
+    EXPINT_STATS_E2,
+    EXPINT_STATS_EN,
+    EXPINT_STATS_GAMMA_INC,
+    EXPINT_STATS_E1_BATCH,	/* also expint_E1_vec() */
+    EXPINT_STATS_E2_BATCH,	/* also expint_E2_vec() */
+    EXPINT_STATS_EN_SEQ,
+    EXPINT_STATS_GAMMA_INC_LADDER,
+    EXPINT_STATS_EN_DERIV,
+    EXPINT_STATS_GAMMA_INC_DERIV,
+    EXPINT_STATS_GAMMA_INC_LOG,	/* also gamma_inc_scaled() */
+    EXPINT_STATS_EN_INV,
+    EXPINT_STATS_GAMMA_INC_INV,
+    EXPINT_STATS_NENTRIES
+};
+
+/* Bin 0 counts 0 and 1; bin b counts [2^b, 2^(b+1)); the last bin is
+ * open */
+#define EXPINT_STATS_NBINS 14
+
+typedef struct {
+    unsigned long long E1[EXPINT_STATS_E1_NREGIONS];
+    unsigned long long gamma_inc[EXPINT_STATS_GI_NBRANCHES];
+    unsigned long long cf_iterations[EXPINT_STATS_NBINS];
+    unsigned long long recursion_steps[EXPINT_STATS_NBINS];
+    unsigned long long calls[EXPINT_STATS_NENTRIES];
+    unsigned long long nanoseconds[EXPINT_STATS_NENTRIES];
+} expint_stats_t;
+
+void expint_stats_enable(int on);
+int expint_stats_enabled(void);
+void expint_stats_get(expint_stats_t *stats);
+void expint_stats_reset(void);
+
+/* Memoization of gamma_inc() and of expint_En() for orders n > 2
+ * (opt-in at run time). The cache holds at least 'size' values, or
+ * none when 'size' is 0, in which case it is disabled; the least
+ * recently used values are replaced first. It is shared by all
+ * threads, but expint_cache_enable() and expint_cache_clear() must
+ * not be called while other threads compute. expint_cache_enable()
+ * returns -1 when memory cannot be allocated, 0 otherwise. */
+int expint_cache_enable(size_t size);
+void expint_cache_clear(void);
+void expint_cache_info(size_t *size, unsigned long long *hits,
+		       unsigned long long *misses);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBEXPINT_H */
@@ -0,0 +1,130 @@
+/*  == expint: Exponential Integral and Incomplete Gamma Function ==
+ *
+ *  Instrumentation of the workhorses: counts per region of
+ *  expint_E1() and per branch of gamma_inc(), histograms of the
+ *  number of iterations of the continued fraction and of the steps
+ *  of the recursion in 'a', number of calls and cumulative time per
+ *  entry point.
+ *
+ *  The instrumentation is disabled by default and the workhorses then
+ *  only pay for a test of 'expint_stats_on'. When the library is
+ *  compiled with EXPINT_NO_STATS defined, the tests are compiled out
+ *  and expint_stats_enable() has no effect. Counters are shared by
+ *  all threads and updated atomically.
+ *
+ *  This file is part of libexpint, the core of package expint that
+ *  does not depend on R; see the Makefile in this directory.
+ *
+ *  Copyright (C) 2026 Vincent Goulet
+ *
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU General Public License as
+ *  published by the Free Software Foundation; either version 3 of the
+ *  License, or (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ *  General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ *  02110-1301, USA.
+ *
+ *  AUTHOR: Vincent Goulet <vincent.goulet@act.ulaval.ca>
+ */
+
+#if !defined(_POSIX_C_SOURCE) || _POSIX_C_SOURCE < 199309L
+#undef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 199309L	/* for clock_gettime() */
+#endif
+#include <string.h>
+#include <time.h>
+#include "core.h"
+
+#ifdef __GNUC__
+#define ADD(p, n) __atomic_fetch_add((p), (n), __ATOMIC_RELAXED)
+#else
+#define ADD(p, n) (*(p) += (n))
+#endif
+
+int expint_stats_on = 0;
+static expint_stats_t stats;
+
+void expint_stats_enable(int on)
+{
+#ifndef EXPINT_NO_STATS
+    expint_stats_on = (on != 0);
+#else
+    (void) on;
+#endif
+}
+
+int expint_stats_enabled(void)
+{
+    return EXPINT_STATS_ON;
+}
+
+void expint_stats_get(expint_stats_t *s)
+{
+    memcpy(s, &stats, sizeof(stats));
+}
+
+void expint_stats_reset(void)
+{
+    memset(&stats, 0, sizeof(stats));
+}
+
+/* Histogram bin of a number of iterations */
+static int bin(int n)
+{
+    int b = 0;
+
+    while (n > 1 && b < EXPINT_STATS_NBINS - 1)
+    {
+	n >>= 1;
+	b++;
+    }
+    return b;
+}
+
+void expint_stats_count_E1(int region, unsigned long long n)
+{
+    ADD(&stats.E1[region], n);
+}
+
+void expint_stats_count_gamma_inc(int branch)
+{
+    ADD(&stats.gamma_inc[branch], 1);
+}
+
+void expint_stats_count_cf(int iterations)
+{
+    ADD(&stats.cf_iterations[bin(iterations)], 1);
+}
+
+void expint_stats_count_recursion(int steps)
+{
+    ADD(&stats.recursion_steps[bin(steps)], 1);
+}
+
+/* Monotonic clock in nanoseconds */
+unsigned long long expint_stats_clock(void)
+{
+    struct timespec ts;
+
+#ifdef CLOCK_MONOTONIC
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+#else
+    timespec_get(&ts, TIME_UTC);
+#endif
+    return (unsigned long long) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/* Record a call to 'entry' started at time 'start' */
+void expint_stats_time(int entry, unsigned long long start)
+{
+    ADD(&stats.calls[entry], 1);
+    ADD(&stats.nanoseconds[entry], expint_stats_clock() - start);
+}
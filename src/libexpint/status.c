@@ -0,0 +1,108 @@
+/*  == expint: Exponential Integral and Incomplete Gamma Function ==
+ *
+ *  Recording of the conditions (overflow, underflow, etc.) met by
+ *  the workhorses.
+ *
+ *  The workhorses record the conditions met with expint_signal().
+ *  Each thread keeps the kinds of conditions met since the last call
+ *  to expint_take_status() to provide a status per element, and the
+ *  number of each condition met since the last call to
+ *  expint_take_counts(). The application may also install a handler
+ *  called each time a condition is met; the R interface uses it to
+ *  issue warnings.
+ *
+ *  The file also holds the other state kept per thread, namely the
+ *  precision of the computations set with expint_set_precision().
+ *
+ *  This file is part of libexpint, the core of package expint that
+ *  does not depend on R; see the Makefile in this directory.
+ *
+ *  Copyright (C) 2026 Vincent Goulet
+ *
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU General Public License as
+ *  published by the Free Software Foundation; either version 3 of the
+ *  License, or (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ *  General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ *  02110-1301, USA.
+ *
+ *  AUTHOR: Vincent Goulet <vincent.goulet@act.ulaval.ca>
+ */
+
+#include "core.h"
+
+/* Kind of each condition, as reported in the status of an element */
+static const int kind[EXPINT_NCONDITIONS] = {
+    EXPINT_STATUS_OVERFLOW,	/* EXPINT_E1_OVERFLOW  */
+    EXPINT_STATUS_UNDERFLOW,	/* EXPINT_E1_UNDERFLOW */
+    EXPINT_STATUS_OVERFLOW,	/* EXPINT_E2_OVERFLOW  */
+    EXPINT_STATUS_UNDERFLOW,	/* EXPINT_E2_UNDERFLOW */
+    EXPINT_STATUS_UNDERFLOW,	/* EXPINT_EN_UNDERFLOW */
+    EXPINT_STATUS_MAXITER	/* EXPINT_CF_MAXITER   */
+};
+
+/* Per thread status and counts */
+static EXPINT_TLS int status = 0;
+static EXPINT_TLS size_t count[EXPINT_NCONDITIONS];
+EXPINT_TLS unsigned int expint_nsignals = 0;
+
+/* Handler installed by the application, if any */
+static void (*handler)(int) = NULL;
+
+/* Record condition 'cond'; this is the only routine of this file
+ * called by the workhorses */
+void expint_signal(int cond)
+{
+    status |= kind[cond];
+    count[cond]++;
+    expint_nsignals++;
+
+    if (handler != NULL)
+	handler(cond);
+}
+
+/* Return the kinds of conditions met by the current thread since the
+ * last call, and reset */
+int expint_take_status(void)
+{
+    int s = status;
+    status = 0;
+    return s;
+}
+
+/* Store in 'counts' the number of each condition met by the current
+ * thread since the last call, and reset */
+void expint_take_counts(size_t *counts)
+{
+    int cond;
+
+    for (cond = 0; cond < EXPINT_NCONDITIONS; cond++)
+    {
+	counts[cond] = count[cond];
+	count[cond] = 0;
+    }
+}
+
+void expint_set_signal_handler(void (*h)(int))
+{
+    handler = h;
+}
+
+/* Per thread precision of the computations */
+EXPINT_TLS int expint_prec = EXPINT_PREC_DOUBLE;
+
+int expint_set_precision(int precision)
+{
+    int old = expint_prec;
+    expint_prec = (precision == EXPINT_PREC_SINGLE) ?
+	EXPINT_PREC_SINGLE : EXPINT_PREC_DOUBLE;
+    return old;
+}
@@ -0,0 +1,216 @@
+/*  == expint: Exponential Integral and Incomplete Gamma Function ==
+ *
+ *  Streaming evaluation over files of double values in the native
+ *  byte order, too large to be held in memory.
+ *
+ *  The input and output files are processed by windows of
+ *  STREAM_WINDOW bytes. On POSIX systems, each window of the input is
+ *  memory-mapped read-only and the corresponding window of the
+ *  output, created at the full size beforehand, is mapped
+ *  read-write; both are unmapped once the window is processed, and
+ *  writeback of the output is started, so that the memory used is
+ *  bounded whatever the size of the files. Elsewhere, the windows are
+ *  read and written with the standard input/output functions. When
+ *  the input and the output are the same file, the values are
+ *  replaced in place.
+ *
+ *  This file is part of libexpint, the core of package expint that
+ *  does not depend on R; see the Makefile in this directory.
+ *
+ *  Copyright (C) 2026 Vincent Goulet
+ *
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU General Public License as
+ *  published by the Free Software Foundation; either version 3 of the
+ *  License, or (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ *  General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ *  02110-1301, USA.
+ *
+ *  AUTHOR: Vincent Goulet <vincent.goulet@act.ulaval.ca>
+ */
+
+#if !defined(_WIN32) && (!defined(_POSIX_C_SOURCE) || _POSIX_C_SOURCE < 200112L)
+#undef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200112L	/* for mmap(), posix_madvise() */
+#endif
+#define _FILE_OFFSET_BITS 64	/* for files over 2 GB */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include "core.h"
+
+/* Size of the windows in bytes; a multiple of the page size */
+#define STREAM_WINDOW ((size_t) 1 << 23)
+
+#ifndef _WIN32
+
+int expint_stream(const char *infile, const char *outfile,
+		  expint_stream_fun f, void *data, int64_t *count)
+{
+    struct stat sin, sout;
+    size_t page = (size_t) sysconf(_SC_PAGESIZE);
+    size_t window = (STREAM_WINDOW > page) ? STREAM_WINDOW / page * page : page;
+    int fdin, fdout, same, res = EXPINT_STREAM_OK;
+    off_t size, off;
+
+    *count = 0;
+
+    fdin = open(infile, O_RDONLY);
+    if (fdin < 0)
+	return EXPINT_STREAM_EINPUT;
+    if (fstat(fdin, &sin) != 0 || !S_ISREG(sin.st_mode) ||
+	sin.st_size % sizeof(double) != 0)
+    {
+	close(fdin);
+	return EXPINT_STREAM_EINPUT;
+    }
+    size = sin.st_size;
+
+    /* not truncated on opening: the output may be the input */
+    fdout = open(outfile, O_RDWR | O_CREAT, 0666);
+    if (fdout < 0)
+    {
+	close(fdin);
+	return EXPINT_STREAM_EOUTPUT;
+    }
+    if (fstat(fdout, &sout) != 0)
+	res = EXPINT_STREAM_EOUTPUT;
+    same = sin.st_dev == sout.st_dev && sin.st_ino == sout.st_ino;
+    if (res == EXPINT_STREAM_OK && !same && ftruncate(fdout, size) != 0)
+	res = EXPINT_STREAM_EOUTPUT;
+
+    for (off = 0; off < size && res == EXPINT_STREAM_OK; off += window)
+    {
+	size_t len = (size - off < (off_t) window) ?
+	    (size_t) (size - off) : window;
+	void *in, *out;
+
+	out = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_SHARED, fdout, off);
+	if (out == MAP_FAILED)
+	{
+	    res = EXPINT_STREAM_EOUTPUT;
+	    break;
+	}
+	if (same)
+	    in = out;
+	else
+	{
+	    in = mmap(NULL, len, PROT_READ, MAP_SHARED, fdin, off);
+	    if (in == MAP_FAILED)
+	    {
+		munmap(out, len);
+		res = EXPINT_STREAM_EINPUT;
+		break;
+	    }
+	    posix_madvise(in, len, POSIX_MADV_SEQUENTIAL);
+	}
+
+	if (f((const double *) in, (double *) out,
+	      (ptrdiff_t) (len / sizeof(double)), data))
+	    res = EXPINT_STREAM_STOPPED;
+	else
+	    *count += len / sizeof(double);
+
+	msync(out, len, MS_ASYNC);
+	if (!same)
+	    munmap(in, len);
+	munmap(out, len);
+    }
+
+    /* the output of an interrupted evaluation holds the values of
+     * the windows completed */
+    if (res == EXPINT_STREAM_STOPPED && !same &&
+	ftruncate(fdout, (off_t) (*count * sizeof(double))) != 0)
+	res = EXPINT_STREAM_EOUTPUT;
+
+    close(fdin);
+    if (close(fdout) != 0 && res == EXPINT_STREAM_OK)
+	res = EXPINT_STREAM_EOUTPUT;
+    return res;
+}
+
+#else
+
+int expint_stream(const char *infile, const char *outfile,
+		  expint_stream_fun f, void *data, int64_t *count)
+{
+    int same = !strcmp(infile, outfile), res = EXPINT_STREAM_OK;
+    FILE *fin, *fout;
+    double *x, *y;
+    size_t nb;
+
+    *count = 0;
+
+    if (same)
+	fin = fout = fopen(outfile, "r+b");
+    else
+    {
+	fin = fopen(infile, "rb");
+	fout = (fin == NULL) ? NULL : fopen(outfile, "wb");
+    }
+    if (fin == NULL)
+	return EXPINT_STREAM_EINPUT;
+    if (fout == NULL)
+    {
+	fclose(fin);
+	return EXPINT_STREAM_EOUTPUT;
+    }
+
+    x = malloc(STREAM_WINDOW);
+    y = same ? x : malloc(STREAM_WINDOW);
+    if (x == NULL || y == NULL)
+	res = EXPINT_STREAM_EOUTPUT;
+
+    while (res == EXPINT_STREAM_OK &&
+	   (nb = fread(x, 1, STREAM_WINDOW, fin)) > 0)
+    {
+	if (nb % sizeof(double) != 0)
+	{
+	    res = EXPINT_STREAM_EINPUT;
+	    break;
+	}
+	if (f(x, y, (ptrdiff_t) (nb / sizeof(double)), data))
+	{
+	    res = EXPINT_STREAM_STOPPED;
+	    break;
+	}
+	/* a seek is required between reading and writing a stream */
+	if ((same && fseek(fout, -(long) nb, SEEK_CUR) != 0) ||
+	    fwrite(y, 1, nb, fout) != nb ||
+	    (same && fseek(fout, 0, SEEK_CUR) != 0))
+	{
+	    res = EXPINT_STREAM_EOUTPUT;
+	    break;
+	}
+	*count += nb / sizeof(double);
+    }
+    if (res == EXPINT_STREAM_OK && ferror(fin))
+	res = EXPINT_STREAM_EINPUT;
+
+    if (!same)
+    {
+	free(y);
+	fclose(fin);
+    }
+    free(x);
+    if (fclose(fout) != 0 && res == EXPINT_STREAM_OK)
+	res = EXPINT_STREAM_EOUTPUT;
+    return res;
+}
+
+#endif
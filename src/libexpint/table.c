@@ -0,0 +1,553 @@
+/*  == expint: Exponential Integral and Incomplete Gamma Function ==
+ *
+ *  Interpolation tables: piecewise Chebyshev expansions of E_1, E_2,
+ *  E_n or the incomplete gamma function (for a fixed value of 'a')
+ *  over a domain [lower, upper] chosen by the user.
+ *
+ *  The domain is bisected until the expansion of degree at most
+ *  TABLE_DEGREE on each piece, interpolating the function at the
+ *  Chebyshev nodes, is within relative tolerance 'tol' of the function
+ *  at the extrema of the Chebyshev polynomial of the same degree. The
+ *  pieces are split at their geometric mean when they do not contain
+ *  zero, so that the pieces get narrower near the singularity of E_1
+ *  at the origin. On pieces where the function changes sign, the
+ *  error is relative to the largest value on the piece. Trailing
+ *  coefficients that do not contribute to the result at the
+ *  requested tolerance are dropped.
+ *
+ *  Evaluation is a lookup in an index of TABLE_CELLS cells over the
+ *  domain, giving the first piece overlapping each cell, followed by
+ *  cheb_eval() on the piece. Only the few cells that overlap more
+ *  than one piece require a search. When the domain does not contain
+ *  zero, the cells are uniform in the bit pattern of |x|, hence about
+ *  uniform in log|x| like the pieces, without the cost of a
+ *  logarithm; otherwise they are uniform in x. The index is built in
+ *  memory when a table is built or loaded.
+ *
+ *  A table is saved in a binary file in the native byte order: a
+ *  header, the breakpoints, the coefficients (TABLE_NCOEF per piece)
+ *  and the orders of the expansions. The file is memory-mapped when
+ *  loaded on POSIX systems, so that processes loading the same file
+ *  share a single read-only copy; elsewhere, it is read in memory.
+ *
+ *  This file is part of libexpint, the core of package expint that
+ *  does not depend on R; see the Makefile in this directory.
+ *
+ *  Copyright (C) 2026 Vincent Goulet
+ *
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU General Public License as
+ *  published by the Free Software Foundation; either version 3 of the
+ *  License, or (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ *  General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ *  02110-1301, USA.
+ *
+ *  AUTHOR: Vincent Goulet <vincent.goulet@act.ulaval.ca>
+ */
+
+#if !defined(_WIN32) && (!defined(_POSIX_C_SOURCE) || _POSIX_C_SOURCE < 200112L)
+#undef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200112L	/* for mmap() */
+#endif
+#include <limits.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include "core.h"
+
+#define TABLE_DEGREE 12		/* maximum degree of the expansions */
+#define TABLE_NCOEF (TABLE_DEGREE + 1)
+#define TABLE_MAXPIECES 65536	/* maximum number of pieces */
+#define TABLE_MAXFITS (4 * TABLE_MAXPIECES)
+#define TABLE_MAGIC "EXPINTTB"
+#define TABLE_VERSION 1
+#define TABLE_PI 3.141592653589793238462643383280
+#define TABLE_CELLS(n) ((n) < 4096 ? 4 * (n) : 16384) /* index size */
+
+/* Header of a table file (64 bytes, no padding) */
+struct table_header {
+    char magic[8];
+    int32_t version;
+    int32_t fun;
+    double check;		/* 1.0, to detect the byte order */
+    double param;
+    double lower;
+    double upper;
+    double tol;
+    int64_t npieces;
+};
+
+struct expint_table {
+    struct table_header h;
+    const double *breaks;	/* npieces + 1 breakpoints */
+    const double *coef;		/* TABLE_NCOEF coefficients per piece */
+    const int32_t *order;	/* order of the expansion on each piece */
+    int32_t *index;		/* first piece overlapping each cell */
+    ptrdiff_t ncells;
+    int bits;			/* cells uniform in the bits of |x| */
+    double origin, scale;	/* key of 'lower' and cells per unit */
+    void *mem;			/* memory block or mapping */
+    size_t size;		/* size of the mapping */
+    int mapped;
+};
+
+static double table_fun(int fun, double param, double x)
+{
+    switch (fun)
+    {
+    case EXPINT_TABLE_E1:
+	return expint_E1(x, 0);
+    case EXPINT_TABLE_E2:
+	return expint_E2(x, 0);
+    case EXPINT_TABLE_EN:
+	return expint_En(x, (int) param, 0);
+    default:
+	return gamma_inc(param, x);
+    }
+}
+
+/* Chebyshev interpolant of the function on [u, v] in 'c' (with its
+ * order in 'order'); returns 1 when within tolerance, 0 otherwise,
+ * and -1 when the function is not finite on the piece */
+static int table_fit(int fun, double param, double u, double v, double tol,
+		     double *c, int *order)
+{
+    const int N = TABLE_NCOEF;
+    double f[TABLE_NCOEF], fmin = INFINITY, fmax = 0.0, tail = 0.0;
+    int j, k, sign = 0;
+
+    for (k = 0; k < N; k++)
+    {
+	double x = 0.5 * (u + v) + 0.5 * (v - u) * cos(TABLE_PI * (k + 0.5)/N);
+	f[k] = table_fun(fun, param, x);
+	if (!isfinite(f[k]))
+	    return -1;
+	if (fabs(f[k]) > fmax) fmax = fabs(f[k]);
+	if (fabs(f[k]) < fmin) fmin = fabs(f[k]);
+	if (f[k] == 0.0 || (sign != 0 && (f[k] > 0.0) != (sign > 0)))
+	    sign = 2;
+	else if (sign == 0)
+	    sign = (f[k] > 0.0) ? 1 : -1;
+    }
+
+    for (j = 0; j < N; j++)
+    {
+	double s = 0.0;
+	for (k = 0; k < N; k++)
+	    s += f[k] * cos(TABLE_PI * j * (k + 0.5)/N);
+	c[j] = 2.0 * s/N;
+    }
+
+    /* Drop the trailing coefficients whose sum is negligible */
+    if (sign == 2)
+	fmin = fmax;
+    for (*order = N - 1; *order > 0; (*order)--)
+    {
+	tail += fabs(c[*order]);
+	if (tail > 0.125 * tol * fmin)
+	    break;
+    }
+
+    /* Check the error at the extrema of T_N, including the ends */
+    cheb_series cs = {c, *order, u, v, *order};
+    for (k = 0; k <= N; k++)
+    {
+	double x = 0.5 * (u + v) + 0.5 * (v - u) * cos(TABLE_PI * k/N);
+	double fx = table_fun(fun, param, x);
+	if (!isfinite(fx))
+	    return -1;
+	if (fabs(cheb_eval(&cs, x, EXPINT_PREC_DOUBLE) - fx) >
+	    tol * (sign == 2 ? fmax : fabs(fx)))
+	    return 0;
+    }
+    return 1;
+}
+
+/* Table under construction */
+struct table_build {
+    int fun, nfits;
+    double param, tol;
+    ptrdiff_t npieces, size;
+    double *breaks, *coef;
+    int32_t *order;
+};
+
+static int table_split(struct table_build *b, double u, double v)
+{
+    double c[TABLE_NCOEF], m;
+    int order, res;
+
+    if (++b->nfits > TABLE_MAXFITS)
+	return -1;
+
+    res = table_fit(b->fun, b->param, u, v, b->tol, c, &order);
+    if (res < 0)
+	return -1;
+    if (res == 0)
+    {
+	/* bisect, at the geometric mean away from zero */
+	m = (u > 0.0 || v < 0.0) ? copysign(sqrt(u * v), u) : 0.5 * (u + v);
+	if (!(m > u && m < v))
+	    return -1;
+	if (table_split(b, u, m) < 0)
+	    return -1;
+	return table_split(b, m, v);
+    }
+
+    if (b->npieces == b->size)
+    {
+	ptrdiff_t size = 2 * b->size;
+	double *breaks, *coef;
+	int32_t *ord;
+
+	if (size > TABLE_MAXPIECES)
+	    return -1;
+	breaks = realloc(b->breaks, (size + 1) * sizeof(double));
+	if (breaks != NULL) b->breaks = breaks;
+	coef = realloc(b->coef, size * TABLE_NCOEF * sizeof(double));
+	if (coef != NULL) b->coef = coef;
+	ord = realloc(b->order, size * sizeof(int32_t));
+	if (ord != NULL) b->order = ord;
+	if (breaks == NULL || coef == NULL || ord == NULL)
+	    return -1;
+	b->size = size;
+    }
+
+    b->breaks[b->npieces] = u;
+    b->breaks[b->npieces + 1] = v;
+    memcpy(b->coef + b->npieces * TABLE_NCOEF, c, TABLE_NCOEF * sizeof(double));
+    b->order[b->npieces++] = order;
+    return 0;
+}
+
+/* Key of 'x' for the index: 'x' itself or the bits of |x| */
+static inline double table_key(const expint_table *table, double x)
+{
+    if (table->bits)
+    {
+	uint64_t u;
+	memcpy(&u, &x, sizeof(u));
+	x = (double) (u & UINT64_C(0x7fffffffffffffff));
+    }
+    return x;
+}
+
+/* Position of 'x' in the cells of the index (non decreasing in 'x') */
+static inline double table_cell(const expint_table *table, double x)
+{
+    return (table_key(table, x) - table->origin) * table->scale;
+}
+
+/* Index of the pieces: entry 'c' is the piece containing the start
+ * of cell 'c'; entry 'ncells' is the last piece */
+static int table_index(expint_table *table)
+{
+    const ptrdiff_t n = table->h.npieces;
+    ptrdiff_t c, p = 0;
+
+    table->ncells = TABLE_CELLS(n);
+    table->bits = table->h.lower > 0.0 || table->h.upper < 0.0;
+    table->origin = 0.0;
+    table->scale = 1.0;
+    table->origin = table_key(table, table->h.lower);
+    table->scale = table->ncells/
+	(table_key(table, table->h.upper) - table->origin);
+    table->index = malloc((table->ncells + 1) * sizeof(int32_t));
+    if (table->index == NULL)
+	return -1;
+
+    for (c = 0; c < table->ncells; c++)
+    {
+	while (p < n - 1 && table_cell(table, table->breaks[p + 1]) <= c)
+	    p++;
+	table->index[c] = (int32_t) p;
+    }
+    table->index[table->ncells] = (int32_t) (n - 1);
+    return 0;
+}
+
+expint_table *expint_table_build(int fun, double param,
+				 double lower, double upper, double tol)
+{
+    struct table_build b = {fun, 0, param, tol, 0, 16, NULL, NULL, NULL};
+    expint_table *table;
+    int prec, res = -1;
+
+    if (fun < EXPINT_TABLE_E1 || fun > EXPINT_TABLE_GAMMA_INC ||
+	!(lower < upper) || !isfinite(lower) || !isfinite(upper) ||
+	!(tol > 0.0) || !isfinite(param))
+	return NULL;
+
+    b.breaks = malloc((b.size + 1) * sizeof(double));
+    b.coef = malloc(b.size * TABLE_NCOEF * sizeof(double));
+    b.order = malloc(b.size * sizeof(int32_t));
+    table = malloc(sizeof(expint_table));
+    if (b.breaks != NULL && b.coef != NULL && b.order != NULL && table != NULL)
+    {
+	prec = expint_set_precision(EXPINT_PREC_DOUBLE);
+	res = table_split(&b, lower, upper);
+	expint_set_precision(prec);
+    }
+
+    if (res < 0)
+    {
+	free(b.breaks);
+	free(b.coef);
+	free(b.order);
+	free(table);
+	return NULL;
+    }
+
+    memset(&table->h, 0, sizeof(table->h));
+    memcpy(table->h.magic, TABLE_MAGIC, 8);
+    table->h.version = TABLE_VERSION;
+    table->h.fun = fun;
+    table->h.check = 1.0;
+    table->h.param = param;
+    table->h.lower = lower;
+    table->h.upper = upper;
+    table->h.tol = tol;
+    table->h.npieces = b.npieces;
+    table->breaks = b.breaks;
+    table->coef = b.coef;
+    table->order = b.order;
+    table->index = NULL;
+    table->mem = NULL;
+    table->size = 0;
+    table->mapped = 0;
+
+    if (table_index(table) < 0)
+    {
+	expint_table_free(table);
+	return NULL;
+    }
+
+    return table;
+}
+
+double expint_table_eval(const expint_table *table, double x)
+{
+    const struct table_header *h = &table->h;
+    ptrdiff_t c, lo, hi, mid;
+
+    if (!(x >= h->lower && x <= h->upper))
+	return isnan(x) ? x : table_fun(h->fun, h->param, x);
+
+    c = (ptrdiff_t) table_cell(table, x);
+    if (c >= table->ncells)
+	c = table->ncells - 1;
+    lo = table->index[c];
+    hi = table->index[c + 1] + 1;
+    while (hi - lo > 1)
+    {
+	mid = (lo + hi)/2;
+	if (x < table->breaks[mid])
+	    hi = mid;
+	else
+	    lo = mid;
+    }
+
+    cheb_series cs = {(double *) table->coef + lo * TABLE_NCOEF,
+		      table->order[lo],
+		      table->breaks[lo], table->breaks[lo + 1],
+		      table->order[lo]};
+    return cheb_eval(&cs, x, EXPINT_PREC_DOUBLE);
+}
+
+void expint_table_eval_vec(const expint_table *table, const double *x,
+			   ptrdiff_t n, double *y)
+{
+    ptrdiff_t i;
+
+    for (i = 0; i < n; i++)
+	y[i] = expint_table_eval(table, x[i]);
+}
+
+int expint_table_save(const expint_table *table, const char *file)
+{
+    const ptrdiff_t n = table->h.npieces;
+    FILE *f = fopen(file, "wb");
+    int ok;
+
+    if (f == NULL)
+	return -1;
+
+    ok = fwrite(&table->h, sizeof(table->h), 1, f) == 1 &&
+	fwrite(table->breaks, sizeof(double), n + 1, f) == (size_t) n + 1 &&
+	fwrite(table->coef, sizeof(double), n * TABLE_NCOEF, f) ==
+	(size_t) n * TABLE_NCOEF &&
+	fwrite(table->order, sizeof(int32_t), n, f) == (size_t) n;
+
+    if (fclose(f) != 0)
+	ok = 0;
+    return ok ? 0 : -1;
+}
+
+/* Size of a table file with 'n' pieces */
+static size_t table_size(int64_t n)
+{
+    return sizeof(struct table_header) + (n + 1) * sizeof(double) +
+	n * TABLE_NCOEF * sizeof(double) + n * sizeof(int32_t);
+}
+
+/* Check of the contents of a loaded table against what
+ * expint_table_build() writes: a finite domain split by strictly
+ * increasing breakpoints, and orders within the coefficients of each
+ * piece */
+static int table_valid(const expint_table *table)
+{
+    const struct table_header *h = &table->h;
+    const int64_t n = h->npieces;
+    int64_t i;
+
+    if (!(h->lower < h->upper) || !isfinite(h->lower) ||
+	!isfinite(h->upper) || !(h->tol > 0.0) || !isfinite(h->param) ||
+	(h->fun == EXPINT_TABLE_EN &&
+	 !(h->param >= 0.0 && h->param <= INT_MAX &&
+	   h->param == floor(h->param))))
+	return 0;
+    if (table->breaks[0] != h->lower || table->breaks[n] != h->upper)
+	return 0;
+    for (i = 0; i < n; i++)
+	if (!(table->breaks[i] < table->breaks[i + 1]) ||
+	    table->order[i] < 0 || table->order[i] >= TABLE_NCOEF)
+	    return 0;
+    return 1;
+}
+
+expint_table *expint_table_load(const char *file)
+{
+    expint_table *table = malloc(sizeof(expint_table));
+    const struct table_header *h;
+    const char *mem;
+    size_t size;
+
+    if (table == NULL)
+	return NULL;
+    table->index = NULL;
+
+#ifndef _WIN32
+    struct stat st;
+    int fd = open(file, O_RDONLY);
+    void *map;
+
+    if (fd < 0)
+    {
+	free(table);
+	return NULL;
+    }
+    if (fstat(fd, &st) != 0 ||
+	(size_t) st.st_size < sizeof(struct table_header))
+    {
+	close(fd);
+	free(table);
+	return NULL;
+    }
+    size = (size_t) st.st_size;
+    map = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);		/* the mapping remains valid */
+    if (map == MAP_FAILED)
+    {
+	free(table);
+	return NULL;
+    }
+    table->mem = map;
+    table->mapped = 1;
+#else
+    FILE *f = fopen(file, "rb");
+    void *buf = NULL;
+    long len;
+
+    if (f == NULL || fseek(f, 0, SEEK_END) != 0 || (len = ftell(f)) < 0 ||
+	(size_t) len < sizeof(struct table_header) ||
+	fseek(f, 0, SEEK_SET) != 0 || (buf = malloc(len)) == NULL ||
+	fread(buf, 1, len, f) != (size_t) len)
+    {
+	if (f != NULL) fclose(f);
+	free(buf);
+	free(table);
+	return NULL;
+    }
+    fclose(f);
+    size = (size_t) len;
+    table->mem = buf;
+    table->mapped = 0;
+#endif
+    table->size = size;
+
+    /* Validate the header before pointing into the file */
+    mem = table->mem;
+    h = (const struct table_header *) mem;
+    if (memcmp(h->magic, TABLE_MAGIC, 8) != 0 ||
+	h->version != TABLE_VERSION || h->check != 1.0 ||
+	h->fun < EXPINT_TABLE_E1 || h->fun > EXPINT_TABLE_GAMMA_INC ||
+	h->npieces < 1 || h->npieces > TABLE_MAXPIECES ||
+	table_size(h->npieces) != size)
+    {
+	expint_table_free(table);
+	return NULL;
+    }
+
+    table->h = *h;
+    table->breaks = (const double *) (mem + sizeof(struct table_header));
+    table->coef = table->breaks + h->npieces + 1;
+    table->order = (const int32_t *) (table->coef + h->npieces * TABLE_NCOEF);
+
+    if (!table_valid(table) || table_index(table) < 0)
+    {
+	expint_table_free(table);
+	return NULL;
+    }
+
+    return table;
+}
+
+void expint_table_free(expint_table *table)
+{
+    if (table == NULL)
+	return;
+
+    free(table->index);
+    if (table->mem == NULL)	/* built in memory */
+    {
+	free((void *) table->breaks);
+	free((void *) table->coef);
+	free((void *) table->order);
+    }
+#ifndef _WIN32
+    else if (table->mapped)
+	munmap(table->mem, table->size);
+#endif
+    else
+	free(table->mem);
+    free(table);
+}
+
+void expint_table_info(const expint_table *table, int *fun, double *param,
+		       double *lower, double *upper, double *tol,
+		       ptrdiff_t *npieces, int *mapped)
+{
+    *fun = table->h.fun;
+    *param = table->h.param;
+    *lower = table->h.lower;
+    *upper = table->h.upper;
+    *tol = table->h.tol;
+    *npieces = (ptrdiff_t) table->h.npieces;
+    *mapped = table->mapped;
+}
@@ -0,0 +1,139 @@
+/*  == expint: Exponential Integral and Incomplete Gamma Function ==
+ *
+ *  R interface to the instrumentation of the workhorses; see
+ *  libexpint/stats.c.
+ *
+ *  Copyright (C) 2026 Vincent Goulet
+ *
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU General Public License as
+ *  published by the Free Software Foundation; either version 3 of the
+ *  License, or (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ *  General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ *  02110-1301, USA.
+ *
+ *  AUTHOR: Vincent Goulet <vincent.goulet@act.ulaval.ca>
+ */
+
+#include <stdio.h>
+#include <R.h>
+#include <Rinternals.h>
+#include "locale.h"
+#include "expint.h"
+
+static const char *E1_names[EXPINT_STATS_E1_NREGIONS] = {
+    "(-Inf,-10]", "(-10,-4]", "(-4,-1]", "(-1,1]", "(1,4]", "(4,Inf)",
+    "other"
+};
+
+static const char *gamma_inc_names[EXPINT_STATS_GI_NBRANCHES] = {
+    "x = 0", "a = 0", "a > 0", "asymptotic", "continued fraction",
+    "-0.5 < a < 0", "series", "recursion"
+};
+
+static const char *entry_names[EXPINT_STATS_NENTRIES] = {
+    "expint_E1", "expint_E2", "expint_En", "gamma_inc",
+    "expint_E1_batch", "expint_E2_batch", "expint_En_seq",
+    "gamma_inc_ladder", "expint_En_deriv", "gamma_inc_deriv",
+    "gamma_inc_log", "expint_En_inv", "gamma_inc_inv"
+};
+
+/* Named numeric vector of counts */
+static SEXP counts(const unsigned long long *x, int n, const char **names)
+{
+    SEXP sy, snames;
+    int i;
+
+    PROTECT(sy = allocVector(REALSXP, n));
+    PROTECT(snames = allocVector(STRSXP, n));
+    for (i = 0; i < n; i++)
+    {
+	REAL(sy)[i] = (double) x[i];
+	SET_STRING_ELT(snames, i, mkChar(names[i]));
+    }
+    setAttrib(sy, R_NamesSymbol, snames);
+    UNPROTECT(2);
+
+    return sy;
+}
+
+/* Histogram by powers of two */
+static SEXP histogram(const unsigned long long *x)
+{
+    char buf[EXPINT_STATS_NBINS][16];
+    const char *names[EXPINT_STATS_NBINS];
+    int b;
+
+    for (b = 0; b < EXPINT_STATS_NBINS; b++)
+    {
+	if (b == 0)
+	    snprintf(buf[b], sizeof(buf[b]), "0-1");
+	else if (b == EXPINT_STATS_NBINS - 1)
+	    snprintf(buf[b], sizeof(buf[b]), "%d+", 1 << b);
+	else
+	    snprintf(buf[b], sizeof(buf[b]), "%d-%d", 1 << b,
+		     (1 << (b + 1)) - 1);
+	names[b] = buf[b];
+    }
+
+    return counts(x, EXPINT_STATS_NBINS, names);
+}
+
+/* Function called by .External() to get the statistics */
+SEXP expint_do_stats(SEXP args)
+{
+    SEXP sy, snames;
+    expint_stats_t s;
+    const char *names[] = {
+	"enabled", "E1", "gamma_inc", "cf_iterations", "recursion_steps",
+	"calls", "nanoseconds"
+    };
+    int i;
+
+    expint_stats_get(&s);
+
+    PROTECT(sy = allocVector(VECSXP, 7));
+    SET_VECTOR_ELT(sy, 0, ScalarLogical(expint_stats_enabled()));
+    SET_VECTOR_ELT(sy, 1, counts(s.E1, EXPINT_STATS_E1_NREGIONS, E1_names));
+    SET_VECTOR_ELT(sy, 2, counts(s.gamma_inc, EXPINT_STATS_GI_NBRANCHES,
+				 gamma_inc_names));
+    SET_VECTOR_ELT(sy, 3, histogram(s.cf_iterations));
+    SET_VECTOR_ELT(sy, 4, histogram(s.recursion_steps));
+    SET_VECTOR_ELT(sy, 5, counts(s.calls, EXPINT_STATS_NENTRIES, entry_names));
+    SET_VECTOR_ELT(sy, 6, counts(s.nanoseconds, EXPINT_STATS_NENTRIES,
+				 entry_names));
+
+    PROTECT(snames = allocVector(STRSXP, 7));
+    for (i = 0; i < 7; i++)
+	SET_STRING_ELT(snames, i, mkChar(names[i]));
+    setAttrib(sy, R_NamesSymbol, snames);
+
+    UNPROTECT(2);
+
+    return sy;
+}
+
+/* Function called by .External() to reset the statistics and enable
+ * or disable the instrumentation; returns the previous state */
+SEXP expint_do_stats_reset(SEXP args)
+{
+    int enable, old = expint_stats_enabled();
+
+    args = CDR(args);	       /* drop function name from arguments */
+    enable = asLogical(CAR(args));
+    if (enable == NA_LOGICAL)
+        error(_("invalid arguments"));
+
+    expint_stats_reset();
+    expint_stats_enable(enable);
+
+    return ScalarLogical(old);
+}
@@ -0,0 +1,203 @@
+/*  == expint: Exponential Integral and Incomplete Gamma Function ==
+ *
+ *  Warnings for the conditions (overflow, underflow, etc.) met by
+ *  the workhorses of libexpint.
+ *
+ *  The workhorses do not call warning() themselves: they record the
+ *  conditions met with expint_signal() in libexpint/status.c. Outside
+ *  of the R interface functions, the handler installed by
+ *  expint_signals_init() issues a warning right away, as before. The
+ *  R interface functions rather defer the signals: the counts of each
+ *  thread are merged at the end of each chunk of computations with
+ *  expint_collect_signals(), and a single summary warning per
+ *  condition is issued by expint_flush_signals() from the main
+ *  thread. Since an error may occur between the calls to
+ *  expint_defer_signals() and expint_flush_signals(), the entry points
+ *  run through expint_protect_signals(), which restores the depth of
+ *  deferral on the way out.
+ *
+ *  Copyright (C) 2026 Vincent Goulet
+ *
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU General Public License as
+ *  published by the Free Software Foundation; either version 3 of the
+ *  License, or (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ *  General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ *  02110-1301, USA.
+ *
+ *  AUTHOR: Vincent Goulet <vincent.goulet@act.ulaval.ca>
+ */
+
+#include <R.h>
+#include <Rinternals.h>
+#include "locale.h"
+#include "expint.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/* Merged counts and depth of deferral (main thread) */
+static size_t count[EXPINT_NCONDITIONS];
+static int deferred = 0;
+
+static void expint_warning(int cond, size_t n)
+{
+    if (n == 1)
+    {
+	switch (cond)
+	{
+	case EXPINT_E1_OVERFLOW:
+	    warning(_("overflow in expint_E1"));
+	    break;
+	case EXPINT_E1_UNDERFLOW:
+	    warning(_("underflow in expint_E1"));
+	    break;
+	case EXPINT_E2_OVERFLOW:
+	    warning(_("overflow in expint_E2"));
+	    break;
+	case EXPINT_E2_UNDERFLOW:
+	    warning(_("underflow in expint_E2"));
+	    break;
+	case EXPINT_EN_UNDERFLOW:
+	    warning(_("underflow in expint_En"));
+	    break;
+	case EXPINT_CF_MAXITER:
+	    warning(_("maximum number of iterations reached in gamma_inc_F_CF"));
+	    break;
+	}
+	return;
+    }
+
+    switch (cond)
+    {
+    case EXPINT_E1_OVERFLOW:
+	warning(_("overflow in expint_E1 for %.0f elements"), (double) n);
+	break;
+    case EXPINT_E1_UNDERFLOW:
+	warning(_("underflow in expint_E1 for %.0f elements"), (double) n);
+	break;
+    case EXPINT_E2_OVERFLOW:
+	warning(_("overflow in expint_E2 for %.0f elements"), (double) n);
+	break;
+    case EXPINT_E2_UNDERFLOW:
+	warning(_("underflow in expint_E2 for %.0f elements"), (double) n);
+	break;
+    case EXPINT_EN_UNDERFLOW:
+	warning(_("underflow in expint_En for %.0f elements"), (double) n);
+	break;
+    case EXPINT_CF_MAXITER:
+	warning(_("maximum number of iterations reached in gamma_inc_F_CF for %.0f elements"),
+		(double) n);
+	break;
+    }
+}
+
+static int in_parallel(void)
+{
+#ifdef _OPENMP
+    return omp_in_parallel();
+#else
+    return 0;
+#endif
+}
+
+/* Handler called by libexpint each time a condition is met */
+static void expint_handler(int cond)
+{
+    if (!deferred && !in_parallel())
+	expint_flush_signals();
+}
+
+void expint_signals_init(void)
+{
+    expint_set_signal_handler(expint_handler);
+}
+
+/* Start deferring the warnings until the matching call to
+ * expint_flush_signals() */
+void expint_defer_signals(void)
+{
+    deferred++;
+    expint_take_status();
+}
+
+/* Restore the depth of deferral saved in 'data'; at depth 0, the
+ * conditions counted since then are dropped with the computations
+ * that met them. Nothing to do on a normal exit, the calls to
+ * expint_defer_signals() and expint_flush_signals() being paired. */
+static void expint_restore_signals(void *data)
+{
+    size_t local_count[EXPINT_NCONDITIONS];
+    int cond, depth = *(int *) data;
+
+    if (deferred <= depth)
+	return;
+
+    deferred = depth;
+    if (deferred == 0)
+    {
+	expint_take_counts(local_count);
+	expint_take_status();
+	for (cond = 0; cond < EXPINT_NCONDITIONS; cond++)
+	    count[cond] = 0;
+    }
+}
+
+/* Evaluate fun(data), restoring the depth of deferral of the warnings
+ * if an error occurs in the meantime */
+SEXP expint_protect_signals(SEXP (*fun)(void *), void *data)
+{
+    int depth = deferred;
+
+    return R_ExecWithCleanup(fun, data, expint_restore_signals, &depth);
+}
+
+/* Merge the counts of the current thread with the others */
+void expint_collect_signals(void)
+{
+    size_t local_count[EXPINT_NCONDITIONS];
+    int cond;
+
+    expint_take_counts(local_count);
+    for (cond = 0; cond < EXPINT_NCONDITIONS; cond++)
+    {
+	if (local_count[cond])
+	{
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+	    count[cond] += local_count[cond];
+	}
+    }
+}
+
+/* Issue one warning per condition met, unless deferred by an
+ * enclosing call to expint_defer_signals() */
+void expint_flush_signals(void)
+{
+    int cond;
+
+    if (deferred > 0)
+	deferred--;
+    if (deferred > 0 || in_parallel())
+	return;
+
+    expint_collect_signals();
+    for (cond = 0; cond < EXPINT_NCONDITIONS; cond++)
+    {
+	if (count[cond])
+	{
+	    size_t n = count[cond];
+	    count[cond] = 0;
+	    expint_warning(cond, n);
+	}
+    }
+}
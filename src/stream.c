@@ -0,0 +1,178 @@
+/*  == expint: Exponential Integral and Incomplete Gamma Function ==
+ *
+ *  R interface to the streaming evaluation of the exponential
+ *  integral and of the incomplete gamma function over binary files;
+ *  see libexpint/stream.c. Each window of the files is evaluated by
+ *  chunks of EXPINT_CHUNK values, with the same kernels as the lazy
+ *  results, split among threads; interrupts are checked between
+ *  windows.
+ *
+ *  Copyright (C) 2026 Vincent Goulet
+ *
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU General Public License as
+ *  published by the Free Software Foundation; either version 3 of the
+ *  License, or (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ *  General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ *  02110-1301, USA.
+ *
+ *  AUTHOR: Vincent Goulet <vincent.goulet@act.ulaval.ca>
+ */
+
+#include <limits.h>
+#include <string.h>
+#include <R.h>
+#include <Rinternals.h>
+#include "locale.h"
+#include "expint.h"
+
+/* Function (one of EXPINT_LAZY_*) and its parameters */
+struct stream_spec {
+    int fun;
+    double a;			/* order or parameter 'a' */
+    int scale;			/* as for the lazy results */
+    double y0;			/* value at x = 0 (gammainc only) */
+    int nthreads;
+    int naflag;
+};
+
+static void stream_check_interrupt(void *data)
+{
+    R_CheckUserInterrupt();
+}
+
+/* Evaluation of a window of the files; returns non zero when the
+ * user interrupted the computations */
+static int stream_window(const double *x, double *y, ptrdiff_t n,
+			 void *data)
+{
+    struct stream_spec *spec = data;
+    ptrdiff_t c, nchunks = (n + EXPINT_CHUNK - 1) / EXPINT_CHUNK;
+    int naflag = 0, nthreads = spec->nthreads;
+
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nthreads) schedule(dynamic, 1) \
+    reduction(||:naflag) if (nthreads > 1)
+#endif
+    for (c = 0; c < nchunks; c++)
+    {
+	ptrdiff_t i, start = c * EXPINT_CHUNK;
+	ptrdiff_t len = (n - start < EXPINT_CHUNK) ? n - start : EXPINT_CHUNK;
+	double xc[EXPINT_CHUNK], *yc = y + start;
+
+	/* the input may be the output */
+	memcpy(xc, x + start, len * sizeof(double));
+
+	switch (spec->fun)
+	{
+	case EXPINT_LAZY_E1:
+	    expint_E1_batch(xc, yc, len, spec->scale);
+	    break;
+	case EXPINT_LAZY_E2:
+	    expint_E2_batch(xc, yc, len, spec->scale);
+	    break;
+	case EXPINT_LAZY_EN:
+	    for (i = 0; i < len; i++)
+		yc[i] = ISNAN(xc[i]) ? xc[i] :
+		    expint_En(xc[i], (int) spec->a, spec->scale);
+	    break;
+	case EXPINT_LAZY_GAMMA_INC:
+	    for (i = 0; i < len; i++)
+		yc[i] = ISNAN(xc[i]) ? xc[i] :
+		    (xc[i] == 0.0) ? spec->y0 :
+		    expint_gamma_inc(spec->a, xc[i],
+				     EXPINT_GAMMA_INC_SCALE(spec->scale),
+				     EXPINT_GAMMA_INC_LOG(spec->scale));
+	    break;
+	}
+	for (i = 0; i < len; i++)
+	    if (ISNAN(yc[i]) && !ISNAN(xc[i])) naflag = 1;
+	expint_collect_signals();
+    }
+
+    if (naflag)
+	spec->naflag = 1;
+
+    return !R_ToplevelExec(stream_check_interrupt, NULL);
+}
+
+/* Function called by .External() to evaluate a function over a file
+ * with arguments: name of the function ("En" or "gammainc"), input
+ * file, output file, order or parameter 'a', scaling, log scale
+ * (incomplete gamma function only) and number of threads. Returns
+ * the number of values written. */
+SEXP expint_do_stream(SEXP args)
+{
+    struct stream_spec spec;
+    const char *name, *file;
+    char *infile, *outfile;
+    int64_t count;
+    int res;
+
+    args = CDR(args);	       /* drop function name from arguments */
+    name = CHAR(STRING_ELT(CAR(args), 0));
+
+    if (!isString(CADR(args)) || !isString(CADDR(args)) ||
+	!isNumeric(CADDDR(args)) || XLENGTH(CADDDR(args)) != 1)
+	error(_("invalid arguments"));
+
+    /* R_ExpandFileName() returns a static buffer */
+    file = R_ExpandFileName(translateChar(STRING_ELT(CADR(args), 0)));
+    infile = strcpy(R_alloc(strlen(file) + 1, sizeof(char)), file);
+    file = R_ExpandFileName(translateChar(STRING_ELT(CADDR(args), 0)));
+    outfile = strcpy(R_alloc(strlen(file) + 1, sizeof(char)), file);
+
+    spec.a = asReal(CADDDR(args));
+    if (ISNAN(spec.a))
+	error(_("invalid arguments"));
+    if (!strcmp(name, "gammainc"))
+    {
+	spec.fun = EXPINT_LAZY_GAMMA_INC;
+	spec.scale = EXPINT_GAMMA_INC_FLAGS(asLogical(CAD4R(args)) == TRUE,
+					    asLogical(CAR(nthcdr(args, 5))) == TRUE);
+	/* G(a, 0) = gamma(a) may issue a warning, hence is computed
+	 * once here rather than in the threads */
+	spec.y0 = expint_gamma_inc(spec.a, 0.0,
+				   EXPINT_GAMMA_INC_SCALE(spec.scale),
+				   EXPINT_GAMMA_INC_LOG(spec.scale));
+    }
+    else
+    {
+	/* the order is passed to the kernels as an int */
+	if (!R_FINITE(spec.a) || spec.a < 0 || spec.a >= INT_MAX ||
+	    spec.a != floor(spec.a))
+	    error(_("invalid arguments"));
+	spec.fun = (spec.a == 1) ? EXPINT_LAZY_E1 :
+	    (spec.a == 2) ? EXPINT_LAZY_E2 : EXPINT_LAZY_EN;
+	spec.scale = asLogical(CAD4R(args)) == TRUE;
+    }
+    spec.nthreads = expint_nthreads(CAR(nthcdr(args, 6)));
+    spec.naflag = 0;
+
+    expint_defer_signals();
+    res = expint_stream(infile, outfile, stream_window, &spec, &count);
+    expint_flush_signals();
+
+    switch (res)
+    {
+    case EXPINT_STREAM_EINPUT:
+	error(_("cannot read double values from file '%s'"), infile);
+    case EXPINT_STREAM_EOUTPUT:
+	error(_("cannot write file '%s'"), outfile);
+    case EXPINT_STREAM_STOPPED:
+	error(_("interrupted after %.0f values"), (double) count);
+    }
+
+    if (spec.naflag)
+	warning(R_MSG_NA);
+
+    return ScalarReal((double) count);
+}
@@ -0,0 +1,212 @@
+/*  == expint: Exponential Integral and Incomplete Gamma Function ==
+ *
+ *  R interface to the interpolation tables of libexpint; see
+ *  libexpint/table.c. Tables are held in external pointers freed by
+ *  a finalizer.
+ *
+ *  Copyright (C) 2026 Vincent Goulet
+ *
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU General Public License as
+ *  published by the Free Software Foundation; either version 3 of the
+ *  License, or (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ *  General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ *  02110-1301, USA.
+ *
+ *  AUTHOR: Vincent Goulet <vincent.goulet@act.ulaval.ca>
+ */
+
+#include <string.h>
+#include <R.h>
+#include <Rinternals.h>
+#include "locale.h"
+#include "expint.h"
+
+static const char *fun_names[] = {"E1", "E2", "En", "gammainc"};
+
+static void table_finalizer(SEXP ptr)
+{
+    expint_table_free((expint_table *) R_ExternalPtrAddr(ptr));
+    R_ClearExternalPtr(ptr);
+}
+
+static SEXP table_pointer(expint_table *table)
+{
+    SEXP ptr;
+
+    PROTECT(ptr = R_MakeExternalPtr(table, install("expint_table"),
+				    R_NilValue));
+    R_RegisterCFinalizerEx(ptr, table_finalizer, TRUE);
+    UNPROTECT(1);
+
+    return ptr;
+}
+
+/* Table held by an external pointer; a pointer restored from a saved
+ * workspace is NULL */
+static expint_table *table_address(SEXP ptr)
+{
+    expint_table *table;
+
+    if (TYPEOF(ptr) != EXTPTRSXP ||
+	R_ExternalPtrTag(ptr) != install("expint_table"))
+	error(_("invalid arguments"));
+    table = (expint_table *) R_ExternalPtrAddr(ptr);
+    if (table == NULL)
+	error(_("invalid table; use expint_table_load() to restore a saved table"));
+
+    return table;
+}
+
+/* Function called by .External() to build a table */
+SEXP expint_do_table(SEXP args)
+{
+    expint_table *table;
+    const char *name;
+    int fun;
+
+    args = CDR(args);	       /* drop function name from arguments */
+    name = CHAR(STRING_ELT(CAR(args), 0));
+    for (fun = EXPINT_TABLE_E1; fun <= EXPINT_TABLE_GAMMA_INC; fun++)
+	if (!strcmp(name, fun_names[fun]))
+	    break;
+    if (fun > EXPINT_TABLE_GAMMA_INC)
+	error(_("invalid arguments"));
+
+    expint_defer_signals();
+    table = expint_table_build(fun, asReal(CADR(args)), asReal(CADDR(args)),
+			       asReal(CADDDR(args)), asReal(CAD4R(args)));
+    expint_flush_signals();
+    if (table == NULL)
+	error(_("cannot build the table: function not finite over the domain or tolerance not achieved"));
+
+    return table_pointer(table);
+}
+
+/* Function called by .External() to evaluate a table; the values are
+ * read by blocks of EXPINT_BLOCK values */
+SEXP expint_do_table_eval(SEXP args)
+{
+    SEXP sx, sy;
+    R_xlen_t b, c, nx, nchunks;
+    expint_table *table;
+    double *x, *y;
+
+    args = CDR(args);	       /* drop function name from arguments */
+    table = table_address(CAR(args));
+
+    if (!isNumeric(CADR(args)))
+        error(_("invalid arguments"));
+
+    nx = XLENGTH(CADR(args));
+    PROTECT(sx = expint_real_or_integer(CADR(args)));
+    PROTECT(sy = allocVector(REALSXP, nx));
+    x = (double *) R_alloc(EXPINT_BLOCK, sizeof(double));
+    y = REAL(sy);
+
+    int nthreads = expint_nthreads(CADDR(args));
+
+    /* Values outside the domain of the table are computed by the
+     * workhorses, which may signal conditions */
+    expint_defer_signals();
+    for (b = 0; b < nx; b += EXPINT_BLOCK)
+    {
+	R_xlen_t nb = (nx - b < EXPINT_BLOCK) ? nx - b : EXPINT_BLOCK;
+
+	expint_read_real(sx, b, nb, x);
+	nchunks = (nb + EXPINT_CHUNK - 1) / EXPINT_CHUNK;
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nthreads) schedule(static) if (nthreads > 1)
+#endif
+	for (c = 0; c < nchunks; c++)
+	{
+	    R_xlen_t start = c * EXPINT_CHUNK;
+	    R_xlen_t len = (nb - start < EXPINT_CHUNK) ? nb - start : EXPINT_CHUNK;
+
+	    expint_table_eval_vec(table, x + start, len, y + b + start);
+	    expint_collect_signals();
+	}
+    }
+    expint_flush_signals();
+
+    SHALLOW_DUPLICATE_ATTRIB(sy, sx);
+    UNPROTECT(2);
+
+    return sy;
+}
+
+/* Function called by .External() to save a table */
+SEXP expint_do_table_save(SEXP args)
+{
+    expint_table *table;
+    const char *file;
+
+    args = CDR(args);	       /* drop function name from arguments */
+    table = table_address(CAR(args));
+    file = R_ExpandFileName(translateChar(STRING_ELT(CADR(args), 0)));
+
+    if (expint_table_save(table, file) != 0)
+	error(_("cannot write file '%s'"), file);
+
+    return R_NilValue;
+}
+
+/* Function called by .External() to load (map) a table */
+SEXP expint_do_table_load(SEXP args)
+{
+    expint_table *table;
+    const char *file;
+
+    args = CDR(args);	       /* drop function name from arguments */
+    file = R_ExpandFileName(translateChar(STRING_ELT(CAR(args), 0)));
+
+    table = expint_table_load(file);
+    if (table == NULL)
+	error(_("cannot read table from file '%s'"), file);
+
+    return table_pointer(table);
+}
+
+/* Function called by .External() to describe a table */
+SEXP expint_do_table_info(SEXP args)
+{
+    SEXP sy, snames;
+    expint_table *table;
+    double param, lower, upper, tol;
+    ptrdiff_t npieces;
+    int fun, mapped, i;
+    const char *names[] = {
+	"fun", "param", "lower", "upper", "tol", "npieces", "mapped"
+    };
+
+    args = CDR(args);	       /* drop function name from arguments */
+    table = table_address(CAR(args));
+    expint_table_info(table, &fun, &param, &lower, &upper, &tol,
+		      &npieces, &mapped);
+
+    PROTECT(sy = allocVector(VECSXP, 7));
+    SET_VECTOR_ELT(sy, 0, mkString(fun_names[fun]));
+    SET_VECTOR_ELT(sy, 1, ScalarReal(param));
+    SET_VECTOR_ELT(sy, 2, ScalarReal(lower));
+    SET_VECTOR_ELT(sy, 3, ScalarReal(upper));
+    SET_VECTOR_ELT(sy, 4, ScalarReal(tol));
+    SET_VECTOR_ELT(sy, 5, ScalarReal((double) npieces));
+    SET_VECTOR_ELT(sy, 6, ScalarLogical(mapped));
+
+    PROTECT(snames = allocVector(STRSXP, 7));
+    for (i = 0; i < 7; i++)
+	SET_STRING_ELT(snames, i, mkChar(names[i]));
+    setAttrib(sy, R_NamesSymbol, snames);
+
+    UNPROTECT(2);
+
+    return sy;
+}
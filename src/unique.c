@@ -0,0 +1,170 @@
+/*  == expint: Exponential Integral and Incomplete Gamma Function ==
+ *
+ *  Deduplication of the arguments of the R functions: the functions
+ *  are evaluated once per distinct value (or pair of values) of the
+ *  recycled arguments and the results are scattered back.
+ *
+ *  Values are compared by their bit patterns, hence NA and NaN are
+ *  distinct values, as are 0 and -0.
+ *
+ *  Copyright (C) 2026 Vincent Goulet
+ *
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU General Public License as
+ *  published by the Free Software Foundation; either version 3 of the
+ *  License, or (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ *  General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ *  02110-1301, USA.
+ *
+ *  AUTHOR: Vincent Goulet <vincent.goulet@act.ulaval.ca>
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <R.h>
+#include <Rinternals.h>
+#include "expint.h"
+
+/* Bit pattern of element 'i' of a real or integer vector; compact
+ * vectors are not expanded */
+static uint64_t key(SEXP s, R_xlen_t i)
+{
+    uint64_t u;
+    double v;
+
+    if (TYPEOF(s) == INTSXP)
+	return (uint32_t) INTEGER_ELT(s, i);
+    v = REAL_ELT(s, i);
+    memcpy(&u, &v, sizeof(u));
+    return u;
+}
+
+static R_xlen_t hash(uint64_t kx, uint64_t ka, R_xlen_t mask)
+{
+    uint64_t h = kx ^ (ka * 0x9E3779B97F4A7C15ULL);
+
+    /* Final step of splitmix64 to mix the high bits of the doubles
+     * into the low bits */
+    h ^= h >> 30;
+    h *= 0xBF58476D1CE4E5B9ULL;
+    h ^= h >> 27;
+    h *= 0x94D049BB133111EBULL;
+    return (R_xlen_t) ((h ^ (h >> 31)) & (uint64_t) mask);
+}
+
+/* Distinct pairs (sx[i %% nx], sa[i %% na]), i = 0, ..., n - 1, where
+ * 'sa' may be R_NilValue. Stores in '*map' the index of the distinct
+ * pair of each element and in '*first' the index of the first element
+ * holding each distinct pair; returns the number of distinct pairs.
+ *
+ * Deduplication gives up, and returns -1, as soon as more than half
+ * of the elements are found distinct since it would then cost more
+ * than it saves. Memory is allocated with R_alloc(). */
+R_xlen_t expint_unique(SEXP sx, SEXP sa, R_xlen_t n,
+		       R_xlen_t **map, R_xlen_t **first)
+{
+    R_xlen_t i, j, ix, ia, h, m = 0, size = 1024, mask;
+    R_xlen_t nx = XLENGTH(sx), na = isNull(sa) ? 1 : XLENGTH(sa);
+    R_xlen_t *table;
+    uint64_t kx, ka;
+
+    if (n < 2)
+	return -1;
+
+    *map = (R_xlen_t *) R_alloc(n, sizeof(R_xlen_t));
+    *first = (R_xlen_t *) R_alloc(n / 2 + 1, sizeof(R_xlen_t));
+    table = (R_xlen_t *) R_alloc(size, sizeof(R_xlen_t));
+    for (j = 0; j < size; j++) table[j] = -1;
+    mask = size - 1;
+
+    for (i = ix = ia = 0; i < n;
+	 ix = (++ix == nx) ? 0 : ix, ia = (++ia == na) ? 0 : ia, i++)
+    {
+	kx = key(sx, ix);
+	ka = isNull(sa) ? 0 : key(sa, ia);
+	for (h = hash(kx, ka, mask); table[h] >= 0; h = (h + 1) & mask)
+	{
+	    R_xlen_t f = (*first)[table[h]];
+	    if (key(sx, f % nx) == kx && (isNull(sa) || key(sa, f % na) == ka))
+		break;
+	}
+	if (table[h] < 0)
+	{
+	    if (m == n / 2)
+		return -1;
+	    (*first)[m] = i;
+	    table[h] = m++;
+
+	    /* Keep the load of the table under one half */
+	    if (2 * m > size)
+	    {
+		size *= 2;
+		mask = size - 1;
+		table = (R_xlen_t *) R_alloc(size, sizeof(R_xlen_t));
+		for (j = 0; j < size; j++) table[j] = -1;
+		for (j = 0; j < m; j++)
+		{
+		    R_xlen_t f = (*first)[j];
+		    for (h = hash(key(sx, f % nx),
+				  isNull(sa) ? 0 : key(sa, f % na), mask);
+			 table[h] >= 0; h = (h + 1) & mask)
+			;
+		    table[h] = j;
+		}
+		(*map)[i] = m - 1;
+		continue;
+	    }
+	}
+	(*map)[i] = table[h];
+    }
+
+    return m;
+}
+
+/* Values (and status and error, if any) of 'suy' at the distinct arguments
+ * scattered back according to 'map' in the 'n' elements of 'y', the
+ * storage of 'sy', along with the attributes of 'sattr'. */
+void expint_scatter(SEXP suy, R_xlen_t n, const R_xlen_t *map, SEXP sattr,
+		    SEXP sy, double *y)
+{
+    SEXP sust, sst, suerr, serr;
+    R_xlen_t i;
+    double *uy = REAL(suy);
+
+    for (i = 0; i < n; i++)
+	y[i] = uy[map[i]];
+    if (!isNull(sattr))
+	SHALLOW_DUPLICATE_ATTRIB(sy, sattr);
+
+    sust = getAttrib(suy, install("status"));
+    if (!isNull(sust))
+    {
+	int *ust = INTEGER(sust), *st;
+	PROTECT(sst = allocVector(INTSXP, n));
+	st = INTEGER(sst);
+	for (i = 0; i < n; i++)
+	    st[i] = ust[map[i]];
+	setAttrib(sy, install("status"), sst);
+	UNPROTECT(1);
+    }
+
+    suerr = getAttrib(suy, install("error"));
+    if (!isNull(suerr))
+    {
+	double *uerr = REAL(suerr), *err;
+	PROTECT(serr = allocVector(REALSXP, n));
+	err = REAL(serr);
+	for (i = 0; i < n; i++)
+	    err[i] = uerr[map[i]];
+	setAttrib(sy, install("error"), serr);
+	UNPROTECT(1);
+    }
+}